@@ -18,7 +18,14 @@ along with this program. If not, see <http://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <thread>
+#include <vector>
+
+#include <boost/asio.hpp>
+#include <boost/thread/tss.hpp>
 
 #include <Poco/AutoPtr.h>
 #include <Poco/Data/Session.h>
@@ -38,17 +45,63 @@ class AbstractExt
 		struct resultData
 		{
 			std::string message;
+			std::string::size_type message_pos = 0; // Read Cursor for Multi-Part Results
 			bool wait = true;
 		};
 
 		// Database Connection Info
 		struct DBConnectionInfo
 		{
+			DBConnectionInfo() : sessions_exhausted(0), read_replica_counter(0), read_replica_fallbacks(0), replica_lag(0), replica_healthy(true)
+			{
+				for (auto &wait_bucket : wait_histogram)
+				{
+					wait_bucket = 0;
+				}
+				wait_histogram_checked.fill(0);
+			}
+
 			std::string type;
 
 			// SQL Database Session Pool
 			std::unique_ptr<Poco::Data::SessionPool> sql_pool;
-			std::mutex mutex_sql_pool;
+
+			// Sticky Sessions, each Thread keeps its Session + Cached Statements, only first call per Thread checks out from Session Pool
+			//   Declared after sql_pool, so Sessions are returned before the Pool is destroyed
+			struct stickySession
+			{
+				stickySession(const Poco::Data::Session &session_, const Poco::Data::SessionPool::SessionDataPtr &session_data_ptr_) : session(session_), session_data_ptr(session_data_ptr_), last_used(std::chrono::steady_clock::now()) {}
+				Poco::Data::Session session;
+				Poco::Data::SessionPool::SessionDataPtr session_data_ptr;
+				std::chrono::steady_clock::time_point last_used; // Idle longer than Pool Check Interval, Session is pinged before it is used again
+			};
+			bool sticky_sessions = true;
+			boost::thread_specific_ptr<stickySession> sticky_session;
+
+			// Session Pool Maintenance (Bulk Worker Lane)
+			//   Keeps Spare Sessions connected ahead of demand + pings Idle Sessions, so calls don't wait on connection setup
+			//   Spare Sessions grow when getting a Session was slow, idle Sessions are closed by the Pool after idleTime
+			std::unique_ptr<boost::asio::deadline_timer> pool_timer;
+			std::mutex mutex_pool_maintenance;
+			bool pool_timer_active = false;
+			int pool_check_interval = 30;
+			int min_spare_sessions = 1;
+			int spare_sessions = 1;
+
+			// Getting a Session Wait Times (ms)  <1, <5, <10, <50, <100, <500, >=500
+			std::array<std::atomic<unsigned int>, 7> wait_histogram;
+			std::array<unsigned int, 7> wait_histogram_checked; // Snapshot at last Pool Maintenance
+			std::atomic<unsigned int> sessions_exhausted;
+
+			// Read Replicas, Read Only Calls Round Robin over Healthy Replicas, else Primary
+			//   Replica Health checked during Session Pool Maintenance, Lag (seconds) -1 == Replication Stopped
+			std::vector<std::unique_ptr<DBConnectionInfo> > read_replicas;
+			std::atomic<unsigned int> read_replica_counter;
+			std::atomic<unsigned int> read_replica_fallbacks;
+			bool read_replica = false;
+			int max_replica_lag = 5;
+			std::atomic<int> replica_lag;
+			std::atomic<bool> replica_healthy;
 		};
 
 		// extDB Connectors
@@ -74,8 +127,10 @@ class AbstractExt
 			std::string log_path;
 
 			int max_threads;
+			int bulk_threads;
 			bool extDB_lock = false;
 			bool logger_flush = true;
+			bool multipart_chunks_hint = false;
 
 		};
 		extInfo ext_info;
@@ -88,14 +143,16 @@ class AbstractExt
 		std::shared_ptr<spdlog::logger> logger;
 		std::shared_ptr<spdlog::logger> vacBans_logger;
 
-		std::mutex player_unique_keys_mutex;
-
-		virtual void saveResult_mutexlock(const unsigned int &unique_id, const resultData &result_data)=0;
-		virtual void saveResult_mutexlock(std::vector<unsigned int> &unique_ids, const resultData &result_data)=0;
+		virtual void saveResult_mutexlock(const unsigned int &unique_id, resultData &result_data)=0;
+		virtual void saveResult_mutexlock(std::vector<unsigned int> &unique_ids, resultData &result_data)=0;
 
+		virtual DBConnectionInfo &getReadDBConnection(DBConnectionInfo &database)=0;
 		virtual Poco::Data::Session getDBSession_mutexlock(DBConnectionInfo &database)=0;
 		virtual Poco::Data::Session getDBSession_mutexlock(DBConnectionInfo &database, Poco::Data::SessionPool::SessionDataPtr &session_data_ptr)=0;
 
+		virtual boost::asio::io_service &getIOService()=0;
+		virtual boost::asio::io_service &getBulkIOService()=0;
+
 		virtual void rconCommand(std::string input_str)=0;
 		virtual void rconAddBan(std::string input_str) = 0;
 		virtual void rconPlayers(unsigned int unique_id)=0;
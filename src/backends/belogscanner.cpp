@@ -18,6 +18,16 @@ along with this program. If not, see <http://www.gnu.org/licenses/>.
 
 #include "belogscanner.h"
 
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+
+#ifdef __linux__
+	#include <unistd.h>
+#endif
+
 #include <boost/algorithm/string.hpp>
 #include <boost/bind.hpp>
 
@@ -30,6 +40,8 @@ along with this program. If not, see <http://www.gnu.org/licenses/>.
 #include <Poco/Process.h>
 #include <Poco/Util/IniFileConfiguration.h>
 
+#include "../hash.h"
+
 
 BELogScanner::BELogScanner()
 {
@@ -65,7 +77,7 @@ void BELogScanner::start(AbstractExt *extension, boost::asio::io_service &io_ser
 		{
 			if (boost::filesystem::is_regular_file(iter->path()))
 			{
-				if ((boost::algorithm::iequals(iter->path().extension().string(), "log") == 1))
+				if (isLogFile(iter->path()))
 				{
 					if (boost::filesystem::last_write_time(iter->path()) > last_shutdown_timestamp)
 					{
@@ -88,7 +100,7 @@ void BELogScanner::start(AbstractExt *extension, boost::asio::io_service &io_ser
 		{
 			if (boost::filesystem::is_regular_file(iter->path()))
 			{
-				if ((boost::algorithm::iequals(iter->path().extension().string(), "log") == 1))
+				if (isLogFile(iter->path()))
 				{
 					boost::filesystem::path dest_file(extension_ptr->ext_info.be_path);
 					dest_file /= "BELogscanner";
@@ -127,24 +139,80 @@ void BELogScanner::start(AbstractExt *extension, boost::asio::io_service &io_ser
 	filters_directory_watcher->itemMovedFrom += Poco::delegate(this, &BELogScanner::reloadFilters);
 	filters_directory_watcher->itemMovedTo += Poco::delegate(this, &BELogScanner::reloadFilters);
 
-	be_directory_watcher.reset(new Poco::DirectoryWatcher(extension_ptr->ext_info.be_path, Poco::DirectoryWatcher::DW_FILTER_ENABLE_ALL, 5));
-	be_directory_watcher->itemAdded += Poco::delegate(this, &BELogScanner::onFileAdded);
-	be_directory_watcher->itemRemoved += Poco::delegate(this, &BELogScanner::onFileRemoved);
-	be_directory_watcher->itemModified += Poco::delegate(this, &BELogScanner::onFileModified);
-	be_directory_watcher->itemMovedFrom += Poco::delegate(this, &BELogScanner::onFileMovedFrom);
-	be_directory_watcher->itemMovedTo += Poco::delegate(this, &BELogScanner::onFileMovedTo);
+	read_buffer.resize(65536);
+	started = true;
+
+	#ifdef __linux__
+		int inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (inotify_fd < 0)
+		{
+			extension_ptr->logger->error("BELogScanner: inotify_init1 Error: {0}", std::strerror(errno));
+			return;
+		}
+		if (inotify_add_watch(inotify_fd, extension_ptr->ext_info.be_path.c_str(), (IN_MODIFY | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO)) < 0)
+		{
+			extension_ptr->logger->error("BELogScanner: inotify_add_watch Error: {0}, Path: {1}", std::strerror(errno), extension_ptr->ext_info.be_path);
+			close(inotify_fd);
+			return;
+		}
+		inotify_stream.reset(new boost::asio::posix::stream_descriptor(*io_service_ptr, inotify_fd));
+		readInotify();
+	#else
+		be_directory_watcher.reset(new Poco::DirectoryWatcher(extension_ptr->ext_info.be_path, Poco::DirectoryWatcher::DW_FILTER_ENABLE_ALL, 5));
+		be_directory_watcher->itemAdded += Poco::delegate(this, &BELogScanner::onFileAdded);
+		be_directory_watcher->itemRemoved += Poco::delegate(this, &BELogScanner::onFileRemoved);
+		be_directory_watcher->itemModified += Poco::delegate(this, &BELogScanner::onFileModified);
+		be_directory_watcher->itemMovedFrom += Poco::delegate(this, &BELogScanner::onFileMovedFrom);
+		be_directory_watcher->itemMovedTo += Poco::delegate(this, &BELogScanner::onFileMovedTo);
+	#endif
+
+	// Logs already there, are tailed from their current end
+	boost::filesystem::directory_iterator iter(extension_ptr->ext_info.be_path);
+	boost::filesystem::directory_iterator iter_end;
+	for (; iter != iter_end; ++iter)
+	{
+		if (boost::filesystem::is_regular_file(iter->path()) && isLogFile(iter->path()))
+		{
+			boost::system::error_code ec;
+			std::streamoff file_size = boost::filesystem::file_size(iter->path(), ec);
+
+			std::lock_guard<std::mutex> lock(belogs_mutex);
+			BELog &belog = belogs[iter->path().stem().string()];
+			belog.f_pos = ec ? 0 : file_size;
+			belog.scan_timer.reset(new boost::asio::deadline_timer(*io_service_ptr));
+		}
+	}
 }
 
 
 void BELogScanner::stop()
 {
-	if (be_directory_watcher)
+	if (!started)
 	{
-		be_directory_watcher.release();
+		return;
 	}
-	if (filters_directory_watcher)
+	started = false;
+
+	#ifdef __linux__
+		if (inotify_stream)
+		{
+			boost::system::error_code ec;
+			inotify_stream->cancel(ec);
+			inotify_stream->close(ec); // Closing inotify fd removes its watches
+		}
+	#else
+		be_directory_watcher.reset();
+	#endif
+	filters_directory_watcher.reset();
 	{
-		filters_directory_watcher.release();
+		std::lock_guard<std::mutex> lock(belogs_mutex);
+		for (auto &belog : belogs)
+		{
+			if (belog.second.scan_timer)
+			{
+				belog.second.scan_timer->cancel();
+			}
+		}
 	}
 
 
@@ -155,7 +223,7 @@ void BELogScanner::stop()
 	{
 		if (boost::filesystem::is_regular_file(iter->path()))
 		{
-			if ((boost::algorithm::iequals(iter->path().extension().string(), "log") == 1))
+			if (isLogFile(iter->path()))
 			{
 				boost::filesystem::path dest_file(extension_ptr->ext_info.be_path);
 				dest_file /= "BELogscanner";
@@ -177,41 +245,157 @@ void BELogScanner::stop()
 }
 
 
-void BELogScanner::onFileAdded(const Poco::DirectoryWatcher::DirectoryEvent& event)
+void BELogScanner::release()
+// Releases inotify stream + Scan Timers, called after the Worker Lane Threads are joined
+//   BELogScanner is destroyed after the io_service they were created on
 {
+	#ifdef __linux__
+		inotify_stream.reset();
+	#endif
 	std::lock_guard<std::mutex> lock(belogs_mutex);
-	belogs[event.item.path()].f_pos = 0;
-	belogs[event.item.path()].log_data = LogData();
-	belogs[event.item.path()].scan_timer.reset(new boost::asio::deadline_timer(*io_service_ptr));
-	scanLog(event.item.path());
+	belogs.clear();
 }
 
 
-void BELogScanner::onFileRemoved(const Poco::DirectoryWatcher::DirectoryEvent& event)
-{
-	std::lock_guard<std::mutex> lock(belogs_mutex);
-	belogs[event.item.path()].scan_timer->cancel();
-	belogs.erase(event.item.path());
-}
+#ifdef __linux__
+	void BELogScanner::readInotify()
+	{
+		inotify_stream->async_read_some(boost::asio::buffer(inotify_buffer), boost::bind(&BELogScanner::onInotify, this, boost::asio::placeholders::error, boost::asio::placeholders::bytes_transferred));
+	}
+
+
+	void BELogScanner::onInotify(const boost::system::error_code &ec, std::size_t bytes_transferred)
+	{
+		if (ec)
+		{
+			if (ec != boost::asio::error::operation_aborted)
+			{
+				extension_ptr->logger->error("BELogScanner: inotify Error: {0}", ec.message());
+			}
+			return;
+		}
+
+		// BattlEye writes a Line at a time, Modified Logs are only scanned once per read of events
+		std::vector<std::string> modified_logs;
+		for (std::size_t pos = 0; (pos + sizeof(inotify_event)) <= bytes_transferred;)
+		{
+			const inotify_event *event = reinterpret_cast<const inotify_event *>(inotify_buffer.data() + pos);
+			pos += sizeof(inotify_event) + event->len;
+			if ((event->len == 0) || (event->mask & IN_ISDIR))
+			{
+				continue;
+			}
+
+			boost::filesystem::path path(extension_ptr->ext_info.be_path);
+			path /= event->name; // Null Terminated
+			if (!isLogFile(path))
+			{
+				continue;
+			}
+
+			if (event->mask & (IN_CREATE | IN_MOVED_TO))
+			{
+				addLog(path.string());
+			}
+			else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+			{
+				modified_logs.erase(std::remove(modified_logs.begin(), modified_logs.end(), path.string()), modified_logs.end());
+				removeLog(path.string());
+			}
+			else if ((event->mask & IN_MODIFY) && (std::find(modified_logs.begin(), modified_logs.end(), path.string()) == modified_logs.end()))
+			{
+				modified_logs.push_back(path.string());
+			}
+		}
+		for (auto &path_str : modified_logs)
+		{
+			scanLog(path_str);
+		}
+		readInotify();
+	}
+#else
+	void BELogScanner::onFileAdded(const Poco::DirectoryWatcher::DirectoryEvent& event)
+	{
+		if (isLogFile(event.item.path()))
+		{
+			addLog(event.item.path());
+		}
+	}
+
+
+	void BELogScanner::onFileRemoved(const Poco::DirectoryWatcher::DirectoryEvent& event)
+	{
+		if (isLogFile(event.item.path()))
+		{
+			removeLog(event.item.path());
+		}
+	}
+
+
+	void BELogScanner::onFileModified(const Poco::DirectoryWatcher::DirectoryEvent& event)
+	{
+		if (isLogFile(event.item.path()))
+		{
+			scanLog(event.item.path());
+		}
+	}
+
+
+	void BELogScanner::onFileMovedFrom(const Poco::DirectoryWatcher::DirectoryEvent& event)
+	{
+		if (isLogFile(event.item.path()))
+		{
+			removeLog(event.item.path());
+		}
+	}
+
+
+	void BELogScanner::onFileMovedTo(const Poco::DirectoryWatcher::DirectoryEvent& event)
+	{
+		if (isLogFile(event.item.path()))
+		{
+			addLog(event.item.path());
+		}
+	}
+#endif
 
 
-void BELogScanner::onFileModified(const Poco::DirectoryWatcher::DirectoryEvent& event)
+bool BELogScanner::isLogFile(const boost::filesystem::path &path)
 {
-	std::lock_guard<std::mutex> lock(belogs_mutex);
-	scanLog(event.item.path());
+	return (boost::algorithm::iequals(path.extension().string(), ".log") == 1);
 }
 
 
-void BELogScanner::onFileMovedFrom(const Poco::DirectoryWatcher::DirectoryEvent& event)
+void BELogScanner::addLog(const std::string &path_str)
+// New / Rotated Log, read from the start
 {
-	std::lock_guard<std::mutex> lock(belogs_mutex);
-	belogs.erase(event.item.path());
+	{
+		std::lock_guard<std::mutex> lock(belogs_mutex);
+		BELog &belog = belogs[boost::filesystem::path(path_str).stem().string()];
+		belog.f_pos = 0;
+		belog.partial_line.clear();
+		belog.log_data = LogData();
+		if (!(belog.scan_timer))
+		{
+			belog.scan_timer.reset(new boost::asio::deadline_timer(*io_service_ptr));
+		}
+	}
+	scanLog(path_str);
 }
 
 
-void BELogScanner::onFileMovedTo(const Poco::DirectoryWatcher::DirectoryEvent& event)
+void BELogScanner::removeLog(const std::string &path_str)
 {
-	//
+	std::lock_guard<std::mutex> lock(belogs_mutex);
+	auto itr = belogs.find(boost::filesystem::path(path_str).stem().string());
+	if (itr != belogs.end())
+	{
+		if (itr->second.scan_timer)
+		{
+			itr->second.scan_timer->cancel();
+		}
+		belogs.erase(itr);
+	}
 }
 
 
@@ -233,6 +417,7 @@ void BELogScanner::loadFilters()
 	boost::filesystem::directory_iterator iter_end;
 
 	std::lock_guard<std::mutex> lock(belogs_mutex);
+	filters_rules.clear(); // Reloaded Filters replace old Filters
 	for (; iter != iter_end; ++iter)
 	{
 		if (boost::filesystem::is_regular_file(iter->path()))
@@ -242,22 +427,21 @@ void BELogScanner::loadFilters()
 			path_str = path.string();
 			file_extension = path.extension().string();
 
-			filename = path.extension().filename().string();
-			filename = filename.substr(0, (filename.size() - file_extension.size()));
+			filename = path.stem().string();
 
-			if (boost::algorithm::iequals(file_extension, "banlist") == 1)
+			if (boost::algorithm::iequals(file_extension, ".banlist") == 1)
 			{
-				loadRegexFile(path_str, filters_rules[filename].banlist_regex);
+				loadRegexFile(path_str, filters_rules[filename].banlist);
 			}
-			else if (boost::algorithm::iequals(file_extension, "kicklist") == 1)
+			else if (boost::algorithm::iequals(file_extension, ".kicklist") == 1)
 			{
-				loadRegexFile(path_str, filters_rules[filename].kicklist_regex);
+				loadRegexFile(path_str, filters_rules[filename].kicklist);
 			}
-			else if (boost::algorithm::iequals(file_extension, "whitelist") == 1)
+			else if (boost::algorithm::iequals(file_extension, ".whitelist") == 1)
 			{
-				loadRegexFile(path_str, filters_rules[filename].whitelist_regex);
+				loadRegexFile(path_str, filters_rules[filename].whitelist);
 			}
-			else if (boost::algorithm::iequals(file_extension, "spamlist") == 1)
+			else if (boost::algorithm::iequals(file_extension, ".spamlist") == 1)
 			{
 				loadSpamFile(path_str, filters_rules[filename].spam_rules);
 			}
@@ -266,32 +450,131 @@ void BELogScanner::loadFilters()
 }
 
 
-void BELogScanner::loadRegexFile(std::string &path_str, std::vector<BELogScanner::Filter> &filters)
+void BELogScanner::loadRegexFile(std::string &path_str, BELogScanner::FilterList &filter_list)
 {
 	Poco::FileInputStream istr(path_str);
 
+	std::string combined_regex_str;
+	std::vector<boost::regex> static_regex;
 	std::string line;
 	while (std::getline(istr, line))
 	{
 		boost::algorithm::trim(line);
 		if ((!(boost::algorithm::starts_with(line, ";"))) && (!(line.empty())))
 		{
-			BELogScanner::Filter filter;
-			if (boost::algorithm::icontains(line, "[:player_key:]"))
+			try
 			{
-				filter.dynamic_regex = true;
-				filter.regex_str = line;
+				if (boost::algorithm::icontains(line, "[:player_key:]"))
+				{
+					BELogScanner::DynamicFilter filter;
+					filter.regex_str = line;
+					filter_list.dynamic_filters.push_back(std::move(filter));
+				}
+				else
+				{
+					boost::regex regex(line, boost::regex::perl | boost::regex::icase); // Syntax Check per Filter
+
+					bool back_reference = false;
+					for (std::string::size_type pos = line.find('\\'); ((pos != std::string::npos) && ((pos + 1) < line.size())); pos = line.find('\\', pos + 2))
+					{
+						const char escaped_char = line[pos + 1];
+						if (((escaped_char >= '1') && (escaped_char <= '9')) || (escaped_char == 'g') || (escaped_char == 'k'))
+						{
+							back_reference = true;
+							break;
+						}
+					}
+
+					if (back_reference)
+					{
+						filter_list.separate_regex.push_back(std::move(regex));
+					}
+					else
+					{
+						if (!combined_regex_str.empty())
+						{
+							combined_regex_str += "|";
+						}
+						combined_regex_str += "(?:" + line + ")";
+						static_regex.push_back(std::move(regex));
+					}
+				}
 			}
-			else
+			catch (boost::regex_error &e)
 			{
-				filter.regex = std::regex(line, std::regex_constants::ECMAScript | std::regex_constants::icase);
+				extension_ptr->logger->warn("BELogScanner: Invalid Regex: {0}, File: {1}, Error: {2}", line, path_str, e.what());
 			}
-			filters.push_back(std::move(filter));
+		}
+	}
+	if (!combined_regex_str.empty())
+	{
+		try
+		{
+			filter_list.combined_regex.assign(combined_regex_str, boost::regex::perl | boost::regex::icase);
+			filter_list.combined = true;
+		}
+		catch (boost::regex_error &e)
+		{
+			// i.e \Q without \E, fall back to searching each Filter
+			extension_ptr->logger->warn("BELogScanner: Unable to Combine Filters, File: {0}, Error: {1}", path_str, e.what());
+			std::move(static_regex.begin(), static_regex.end(), std::back_inserter(filter_list.separate_regex));
 		}
 	}
 }
 
 
+bool BELogScanner::matchFilters(BELogScanner::FilterList &filter_list, const std::string &logged_line, const std::string &player_regex)
+// Called with belogs_mutex locked (Dynamic Filter Regex Cache)
+{
+	if (filter_list.combined && boost::regex_search(logged_line, filter_list.combined_regex, boost::match_any))
+	{
+		return true;
+	}
+	for (auto &regex : filter_list.separate_regex)
+	{
+		if (boost::regex_search(logged_line, regex, boost::match_any))
+		{
+			return true;
+		}
+	}
+	for (auto &dynamic_filter : filter_list.dynamic_filters)
+	{
+		auto itr = dynamic_filter.regex_cache.find(player_regex);
+		if (itr == dynamic_filter.regex_cache.end())
+		{
+			if (dynamic_filter.regex_cache.size() >= 256)
+			{
+				// Player Key Rules change as Players join / leave, keeps Cache bounded
+				dynamic_filter.regex_cache.clear();
+			}
+			std::string regex_str = dynamic_filter.regex_str;
+			boost::algorithm::ireplace_all(regex_str, "[:player_key:]", player_regex);
+			//boost::algorithm::ireplace_all(regex_str, "[:server_key:]", server_key);
+			try
+			{
+				itr = dynamic_filter.regex_cache.insert(std::make_pair(player_regex, boost::regex(regex_str, boost::regex::perl | boost::regex::icase))).first;
+			}
+			catch (boost::regex_error &e)
+			{
+				extension_ptr->logger->warn("BELogScanner: Invalid Regex: {0}, Error: {1}", regex_str, e.what());
+				continue;
+			}
+		}
+		if (boost::regex_search(logged_line, itr->second, boost::match_any))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+void BELogScanner::logFilterMatch(const std::string &list_name, const std::string &filename, const LogData &log_data)
+{
+	extension_ptr->logger->info("{0}: FILE: {1}, PLAYER: {2}, GUID: {3}, IP: {4}, PORT: {5}, LINE: {6}", list_name, filename, log_data.player_name, log_data.player_guid, log_data.player_ip, log_data.player_port, log_data.logged_line);
+}
+
+
 void BELogScanner::loadSpamFile(std::string &path_str, std::vector<BELogScanner::Spam> &spam_rules)
 {
 	std::string action_str;
@@ -341,216 +624,240 @@ void BELogScanner::launchProcess()
 }
 
 
-void BELogScanner::checkLogData(std::string &filename)
+void BELogScanner::checkLogData(const std::string &filename)
 {
-	bool found = false;
-	auto const_itr = filters_rules.find(filename);
-	BELogScanner::LogData log_data = belogs[filename].log_data;
+	auto itr = filters_rules.find(filename);
+	if (itr == filters_rules.end())
+	{
+		return;
+	}
+	BELog &belog = belogs[filename];
+	const LogData &log_data = belog.log_data;
+
+	// Player Keys are read Lock-Free, only looked up once per line
+	const std::string player_regex = extension_ptr->getPlayerRegex_BEGuid(belog.log_data.player_guid);
+
+	// WHITELIST
+	if (matchFilters(itr->second.whitelist, log_data.logged_line, player_regex))
+	{
+		logFilterMatch("WHITELIST", filename, log_data);
+		extension_ptr->logger->info("WHITELISTED");
+		extension_ptr->logger->info("");
+		return;
+	}
 
+	//KICK
+	if (matchFilters(itr->second.kicklist, log_data.logged_line, player_regex))
 	{
-		std::lock_guard<std::mutex> lock(extension_ptr->player_unique_keys_mutex);
-		// WHITELIST
-		for (auto &whitelist : const_itr->second.whitelist_regex)
+		logFilterMatch("KICKLIST", filename, log_data);
+		if (!(belog.kick_logger))
 		{
-			if (whitelist.dynamic_regex)
-			{
-				std::string temp_str = whitelist.regex_str;
-				boost::algorithm::ireplace_all(temp_str, "[:player_key:]", extension_ptr->getPlayerRegex_BEGuid(log_data.player_guid));
-				//boost::algorithm::ireplace_all(temp_str, "[:server_key:]", server_key);
-				std::regex regex(temp_str, std::regex_constants::ECMAScript | std::regex_constants::icase);
-				if (std::regex_search(log_data.logged_line, regex))
-				{
-					extension_ptr->logger->info("WHITELIST: FILE: {0}, PLAYER: {2}, GUID: {3}, IP: {4}, PORT: {5}, LINE: {6}", filename, log_data.player_name, log_data.player_guid, log_data.player_ip, log_data.player_port, log_data.logged_line);
-					found = true;
-					break;
-				}
-			}
-			else
-			{
-				if (std::regex_search(log_data.logged_line, whitelist.regex))
-				{
-					extension_ptr->logger->info("WHITELIST: FILE: {0}, PLAYER: {2}, GUID: {3}, IP: {4}, PORT: {5}, LINE: {6}", filename, log_data.player_name, log_data.player_guid, log_data.player_ip, log_data.player_port, log_data.logged_line);
-					found = true;
-					break;
-				}
-			}
+			boost::filesystem::path path(be_custom_log_path);
+			path /= (filename + "-kick.log");
+			belog.kick_logger.reset(new spdlog::logger(filename + "-kick.log", std::make_shared<spdlog::sinks::simple_file_sink_mt>(path.make_preferred().string(), true)));
 		}
-		if (found)
+		belog.kick_logger->info("{0}", log_data.logged_line);
+		extension_ptr->logger->info("KICK");
+		extension_ptr->logger->info("");
+		return;
+	}
+
+	//BAN
+	if (matchFilters(itr->second.banlist, log_data.logged_line, player_regex))
+	{
+		logFilterMatch("BANLIST", filename, log_data);
+		if (!(belog.ban_logger))
 		{
-			extension_ptr->logger->info("WHITELISTED");
-			extension_ptr->logger->info("");
-			return;
+			boost::filesystem::path path(be_custom_log_path);
+			path /= (filename + "-ban.log");
+			belog.ban_logger.reset(new spdlog::logger(filename + "-ban.log", std::make_shared<spdlog::sinks::simple_file_sink_mt>(path.make_preferred().string(), true)));
 		}
+		belog.ban_logger->info("{0}", log_data.logged_line);
+		extension_ptr->logger->info("BAN");
+		extension_ptr->logger->info("");
+		return;
+	}
 
-		//KICK
-		for (auto &kicklist : const_itr->second.kicklist_regex)
-		{
-			if (kicklist.dynamic_regex)
-			{
-				std::string temp_str = kicklist.regex_str;
-				boost::algorithm::ireplace_all(temp_str, "[:player_key:]", extension_ptr->getPlayerRegex_BEGuid(log_data.player_guid));
-				//boost::algorithm::ireplace_all(temp_str, "[:server_key:]", server_key);
-				std::regex regex(temp_str, std::regex_constants::ECMAScript | std::regex_constants::icase);
-				if (std::regex_search(log_data.logged_line, regex))
-				{
-					extension_ptr->logger->info("KICKLIST: FILE: {0}, PLAYER: {2}, GUID: {3}, IP: {4}, PORT: {5}, LINE: {6}", filename, log_data.player_name, log_data.player_guid, log_data.player_ip, log_data.player_port, log_data.logged_line);
-					found = true;
+	//SPAM
+	// TODO Poco Expire Cache
 
-					if (!(belogs[filename].kick_logger))
-					{
-						boost::filesystem::path path(be_custom_log_path);
-						path /= (filename + "-kick.log");
-						belogs[filename].kick_logger.reset(new spdlog::logger(filename + "-kick.log", std::make_shared<spdlog::sinks::simple_file_sink_mt>(path.make_preferred().string(), true)));
-					}
-					belogs[filename].kick_logger->info("{0}", log_data.logged_line);
-					break;
-				}
-			}
-			else
-			{
-				if (std::regex_search(log_data.logged_line, kicklist.regex))
-				{
-					extension_ptr->logger->info("KICKLIST: FILE: {0}, PLAYER: {2}, GUID: {3}, IP: {4}, PORT: {5}, LINE: {6}", filename, log_data.player_name, log_data.player_guid, log_data.player_ip, log_data.player_port, log_data.logged_line);
-					found = true;
+	// UNKNOWN
+	if (!(belog.unknown_logger))
+	{
+		boost::filesystem::path path(be_custom_log_path);
+		path /= (filename + "-unknown.log");
+		belog.unknown_logger.reset(new spdlog::logger(filename + "-unknown.log", std::make_shared<spdlog::sinks::simple_file_sink_mt>(path.make_preferred().string(), true)));
+	}
+	belog.unknown_logger->info("{0}", log_data.logged_line);
+}
 
-					if (!(belogs[filename].kick_logger))
-					{
-						boost::filesystem::path path(be_custom_log_path);
-						path /= (filename + "-kick.log");
-						belogs[filename].kick_logger.reset(new spdlog::logger(filename + "-kick.log", std::make_shared<spdlog::sinks::simple_file_sink_mt>(path.make_preferred().string(), true)));
-					}
-					belogs[filename].kick_logger->info("{0}", log_data.logged_line);
-					break;
-				}
-			}
-		}
-		if (found)
-		{
-			extension_ptr->logger->info("KICK");
-			extension_ptr->logger->info("");
-			return;
-		}
 
-		//BAN
-		for (auto &banlist : const_itr->second.banlist_regex)
-		{
-			if (banlist.dynamic_regex)
-			{
-				std::string temp_str = banlist.regex_str;
-				boost::algorithm::ireplace_all(temp_str, "[:player_key:]", extension_ptr->getPlayerRegex_BEGuid(log_data.player_guid));
-				//boost::algorithm::ireplace_all(temp_str, "[:server_key:]", server_key);
-				std::regex regex(temp_str, std::regex_constants::ECMAScript | std::regex_constants::icase);
-				if (std::regex_search(log_data.logged_line, regex))
-				{
-					extension_ptr->logger->info("BANLIST: FILE: {0}, PLAYER: {2}, GUID: {3}, IP: {4}, PORT: {5}, LINE: {6}", filename, log_data.player_name, log_data.player_guid, log_data.player_ip, log_data.player_port, log_data.logged_line);
-					found = true;
+void BELogScanner::getBEGUID(std::string &steam_id, std::string &beguid)
+{
+	Hash::getBEGUID(steam_id, beguid);
+}
 
-					if (!(belogs[filename].ban_logger))
-					{
-						boost::filesystem::path path(be_custom_log_path);
-						path /= (filename + "-ban.log");
-						belogs[filename].ban_logger.reset(new spdlog::logger(filename + "-ban.log", std::make_shared<spdlog::sinks::simple_file_sink_mt>(path.make_preferred().string(), true)));
-					}
-					belogs[filename].ban_logger->info("{0}", log_data.logged_line);
-					break;
-				}
-			}
-			else
-			{
-				if (std::regex_search(log_data.logged_line, banlist.regex))
-				{
-					extension_ptr->logger->info("BANLIST: FILE: {0}, PLAYER: {2}, GUID: {3}, IP: {4}, PORT: {5}, LINE: {6}", filename, log_data.player_name, log_data.player_guid, log_data.player_ip, log_data.player_port, log_data.logged_line);
-					found = true;
 
-					if (!(belogs[filename].ban_logger))
-					{
-						boost::filesystem::path path(be_custom_log_path);
-						path /= (filename + "-ban.log");
-						belogs[filename].ban_logger.reset(new spdlog::logger(filename + "-ban.log", std::make_shared<spdlog::sinks::simple_file_sink_mt>(path.make_preferred().string(), true)));
-					}
-					belogs[filename].ban_logger->info("{0}", log_data.logged_line);
-					break;
-				}
-			}
-		}
-		if (found)
-		{
-			extension_ptr->logger->info("BAN");
-			extension_ptr->logger->info("");
-			return;
-		}
+void BELogScanner::parseLine(BELog &belog, const std::string &filename, boost::string_ref line)
+// Line points into read_buffer / partial_line, only LogData strings are assigned (reuse their capacity)
+//   dd.mm.yyyy hh:mm:ss: Player Name (ip:port) beguid - logged line
+{
+	if ((!(line.empty())) && (line.back() == '\r'))
+	{
+		line.remove_suffix(1);
+	}
 
-		//SPAM
-		for (auto &spam_rules : const_itr->second.spam_rules)
-		{
-			// TODO Poco Expire Cache
-			//, std::regex_constants::ECMAScript | std::regex_constants::icase);
-		}
-		if (found)
+	bool timestamp = (line.size() >= 21);
+	for (std::size_t i = 0; timestamp && (i < 21); ++i)
+	{
+		switch (i)
 		{
-			extension_ptr->logger->info("SPAM ACTION");
-			extension_ptr->logger->info("");
-			return;
+			case 2:
+			case 5:
+				timestamp = (line[i] == '.');
+				break;
+			case 10:
+			case 20:
+				timestamp = (line[i] == ' ');
+				break;
+			case 13:
+			case 16:
+			case 19:
+				timestamp = (line[i] == ':');
+				break;
+			default:
+				timestamp = (std::isdigit(static_cast<unsigned char>(line[i])) != 0);
 		}
+	}
+
+	LogData &log_data = belog.log_data;
+	if (!timestamp)
+	{
+		// Continuation of previous Logged Line
+		log_data.logged_line.append(line.data(), line.size());
+		return;
+	}
 
-		// UNKNOWN
-		if (!found)
+	if (!(log_data.player_name.empty()))
+	{
+		checkLogData(filename);
+	}
+	log_data.date_time.assign(line.data(), 19);
+	log_data.player_name.clear();
+	log_data.player_guid.clear();
+	log_data.player_ip.clear();
+	log_data.player_port.clear();
+	line.remove_prefix(21);
+
+	// Player Name can contain anything, search for " (ip:port)"
+	std::size_t ip_start = boost::string_ref::npos;
+	std::size_t ip_end = boost::string_ref::npos;
+	for (std::size_t i = 1; i < line.size(); ++i)
+	{
+		if ((line[i] == '(') && (line[i - 1] == ' '))
 		{
-			if (!(belogs[filename].unknown_logger))
+			std::size_t j = i + 1;
+			while ((j < line.size()) && (std::isdigit(static_cast<unsigned char>(line[j])) || (line[j] == '.') || (line[j] == ':')))
 			{
-				boost::filesystem::path path(be_custom_log_path);
-				path /= (filename + "-unknown.log");
-				belogs[filename].unknown_logger.reset(new spdlog::logger(filename + "-unknown.log", std::make_shared<spdlog::sinks::simple_file_sink_mt>(path.make_preferred().string(), true)));
+				++j;
+			}
+			if ((j < line.size()) && (line[j] == ')') && (j > (i + 1)))
+			{
+				ip_start = i + 1;
+				ip_end = j;
+				break;
 			}
-			belogs[filename].unknown_logger->info("{0}", log_data.logged_line);
 		}
 	}
+	if (ip_start == boost::string_ref::npos)
+	{
+		log_data.logged_line.assign(line.data(), line.size());
+		return;
+	}
+
+	log_data.player_name.assign(line.data(), ip_start - 2);
+	boost::string_ref ip_port = line.substr(ip_start, ip_end - ip_start);
+	std::size_t found = ip_port.rfind(':');
+	if (found == boost::string_ref::npos)
+	{
+		log_data.player_ip.assign(ip_port.data(), ip_port.size());
+	}
+	else
+	{
+		log_data.player_ip.assign(ip_port.data(), found);
+		log_data.player_port.assign(ip_port.data() + found + 1, ip_port.size() - (found + 1));
+	}
+
+	line.remove_prefix(std::min(ip_end + 2, line.size()));  // +2 = )_
+	found = line.find(' ');
+	log_data.player_guid.assign(line.data(), std::min(found, line.size()));
+	if ((found != boost::string_ref::npos) && line.substr(found).starts_with(" - "))
+	{
+		found += 3;
+	}
+	line.remove_prefix(std::min(found, line.size()));
+	log_data.logged_line.assign(line.data(), line.size());  // LEFT WITH #......................................
 }
 
 
-void BELogScanner::getBEGUID(std::string &steam_id, std::string &beguid)
-// From Frank https://gist.github.com/Fank/11127158
-// Modified to use libpoco
+bool BELogScanner::readLog(BELog &belog, const std::string &filename, const std::string &path_str)
+// Called with belogs_mutex locked, returns true if new data was read
 {
-	// Is called from within the same mutex lock, so don't need to worry
-	bool status = true;
-
-	if (steam_id.empty())
+	boost::system::error_code ec;
+	std::streamoff file_size = boost::filesystem::file_size(boost::filesystem::path(path_str), ec);
+	if (ec)
 	{
-		status = false;
+		return false;
 	}
-	else
+
+	if (file_size < belog.f_pos)
 	{
-		for (unsigned int index = 0; index < steam_id.length(); index++)
+		// Truncated / Rotated in place, start again from the beginning
+		extension_ptr->logger->info("BELogScanner: Log Truncated: {0}", path_str);
+		if (!(belog.log_data.player_name.empty()))
 		{
-			if (!std::isdigit(steam_id[index]))
-			{
-				status = false;
-				break;
-			}
+			checkLogData(filename);
 		}
+		belog.f_pos = 0;
+		belog.partial_line.clear();
+		belog.log_data = LogData();
 	}
-
-	if (status)
+	if (file_size == belog.f_pos)
 	{
-		Poco::Int64 steamID = Poco::NumberParser::parse64(steam_id);
-		Poco::Int8 i = 0, parts[8] = { 0 };
+		return false;
+	}
 
-		do
-		{
-			parts[i++] = steamID & 0xFFu;
-		} while (steamID >>= 8);
+	Poco::FileInputStream istr(path_str);
+	istr.seekg(belog.f_pos);
+	while (istr.read(read_buffer.data(), read_buffer.size()) || (istr.gcount() > 0))
+	{
+		const std::streamsize bytes = istr.gcount();
+		belog.f_pos += bytes;
 
-		std::stringstream bestring;
-		bestring << "BE";
-		for (auto &part: parts)
+		const char *start_ptr = read_buffer.data();
+		const char *end_ptr = read_buffer.data() + bytes;
+		while (true)
 		{
-			bestring << char(part);
+			const char *found_ptr = static_cast<const char *>(std::memchr(start_ptr, '\n', (end_ptr - start_ptr)));
+			if (found_ptr == nullptr)
+			{
+				belog.partial_line.append(start_ptr, (end_ptr - start_ptr));
+				break;
+			}
+			if (belog.partial_line.empty())
+			{
+				parseLine(belog, filename, boost::string_ref(start_ptr, (found_ptr - start_ptr)));
+			}
+			else
+			{
+				belog.partial_line.append(start_ptr, (found_ptr - start_ptr));
+				parseLine(belog, filename, belog.partial_line);
+				belog.partial_line.clear();
+			}
+			start_ptr = found_ptr + 1;
 		}
-
-		md5.update(bestring.str());
-		beguid = Poco::DigestEngine::digestToHex(md5.digest());
 	}
+	return true;
 }
 
 
@@ -558,79 +865,107 @@ void BELogScanner::scanLog(std::string path_str)
 {
 	std::lock_guard<std::mutex> lock(belogs_mutex);
 
-	boost::filesystem::path path(path_str);
+	auto itr = belogs.find(boost::filesystem::path(path_str).stem().string());
+	if (itr == belogs.end())
+	{
+		return;
+	}
+	BELog &belog = itr->second;
 
-	std::string filename = path.extension().filename().string();
-	std::string file_extension = path.extension().string();
-	filename = filename.substr(0, (filename.size() - file_extension.size()));
+	if (readLog(belog, itr->first, path_str))
+	{
+		// Rescan in case a Modified event is missed / coalesced (Windows updates Last Write lazily for open files)
+		belog.scan_timer->expires_from_now(boost::posix_time::seconds(3));
+		belog.scan_timer->async_wait(boost::bind(&BELogScanner::timerScanLog, this, boost::asio::placeholders::error, std::move(path_str)));
+	}
+}
 
 
-	Poco::FileInputStream istr(path_str);
+void BELogScanner::timerScanLog(const boost::system::error_code &ec, std::string path_str)
+{
+	if (!ec)
+	{
+		scanLog(std::move(path_str));
+	}
+}
 
-	std::regex regex_date_time ("[0-3][0-9]\\.[0-1][0-9]\\.[0-9][0-9][0-9][0-9][ ][0-2][0-9][:][0-6][0-9][:][0-6][0-9][:]\\s");
-	std::regex regex_ip_port ("[:digit:]{1,3}\\.[:digit:]{1,3}\\.[:digit:]{1,3}\\.[:digit:]{1,3}:[:digit:]{1,5}[0-9]");
 
-	std::string line;
-	std::string::size_type found;
+#if defined(TEST_APP) && defined(DEBUG_TESTING)
+	void BELogScanner::benchmarkFilters(AbstractExt *extension, const std::string &path_str)
+	// Replays a BattlEye Log through its Filters i.e scripts.log uses scripts.whitelist / kicklist / banlist
+	//   Reading the Log + Filter matching are timed separately, nothing is logged
+	//   If BELogScanner isn't started, Filters are loaded from BEPATH (else the Log's Directory)/BELogscanner/filters, no Watchers are started
 	{
-		istr.seekg(belogs[filename].f_pos);
-		while (std::getline(istr, line))
+		const std::string filename = boost::filesystem::path(path_str).stem().string();
+
+		if (!started)
 		{
-			std::smatch match;
-			if (std::regex_search(line, match, regex_date_time, std::regex_constants::match_continuous))
+			extension_ptr = extension;
+			filters_path = boost::filesystem::path(extension_ptr->ext_info.be_path.empty() ? boost::filesystem::path(path_str).parent_path().string() : extension_ptr->ext_info.be_path);
+			filters_path /= "BELogscanner";
+			filters_path /= "filters";
+			if (!boost::filesystem::is_directory(filters_path))
 			{
-				if (!((belogs[filename].log_data).player_name.empty()))
-				{
-					checkLogData(filename);
-				}
-
-				belogs[filename].log_data = LogData();
-				belogs[filename].log_data.date_time = match[0];
-				line = line.substr(line.find(":") + 2);
-
-				std::regex_match(line, match, regex_ip_port);
-				std::string match_str = match[0].str();
-
-				found = match_str.find(":");
-				belogs[filename].log_data.player_ip = match_str.substr(0, (found - 1));
-				belogs[filename].log_data.player_port = match_str.substr(found + 1);
-
-				found = line.find(match_str);
-				belogs[filename].log_data.player_name = line.substr(0, found - 2);  // -2 = _(
-				line = line.substr(found + match_str.size() + 2);
-
-				found = belogs[filename].log_data.player_guid.find(" -");
-				belogs[filename].log_data.player_guid = line.substr(0, found - 1);
-				belogs[filename].log_data.logged_line = line.substr(found + 2);  // LEFT WITH #......................................
+				extension_ptr->console->warn("BELogScanner: Filter Benchmark: No Filters Directory: {0}", filters_path.string());
+				return;
 			}
-			else
+			loadFilters();
+			read_buffer.resize(65536);
+		}
+
+		std::vector<std::string> lines;
+		{
+			Poco::FileInputStream istr(path_str);
+			std::string line;
+			while (std::getline(istr, line))
 			{
-				belogs[filename].log_data.logged_line += line;
+				lines.push_back(line);
 			}
 		}
 
-		if (belogs[filename].f_pos == istr.tellg())
+		std::lock_guard<std::mutex> lock(belogs_mutex);
 		{
-			timerScanLog(0, path_str);
+			// Read + Split + Parse, "" has no Filters
+			BELog belog;
+			auto start = std::chrono::high_resolution_clock::now();
+			readLog(belog, "", path_str);
+			auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+			extension_ptr->console->info("BELogScanner: Read Benchmark: {0} Bytes: {1} Total: {2}ms MB/sec: {3}", filename, belog.f_pos, (elapsed / 1000), (belog.f_pos / std::max<long long>(1, elapsed)));
 		}
-		else
+
+		auto itr = filters_rules.find(filename);
+		if (itr == filters_rules.end())
 		{
-			belogs[filename].f_pos = istr.tellg();
-			timerScanLog(3, path_str);
+			extension_ptr->console->warn("BELogScanner: Filter Benchmark: No Filters for: {0}", filename);
+			return;
 		}
-	}
-}
 
-
-void BELogScanner::timerScanLog(const size_t delay, std::string &belog_path)
-{
-	if (delay == 0)
-	{
-		belogs[belog_path].scan_timer->cancel();
-	}
-	else
-	{
-		belogs[belog_path].scan_timer->expires_from_now(boost::posix_time::seconds(delay));
-		belogs[belog_path].scan_timer->async_wait(std::bind(&BELogScanner::scanLog, this, std::move(belog_path)));
+		const std::string player_regex;
+		int whitelisted = 0;
+		int kicked = 0;
+		int banned = 0;
+		int unknown = 0;
+		auto start = std::chrono::high_resolution_clock::now();
+		for (auto &line : lines)
+		{
+			if (matchFilters(itr->second.whitelist, line, player_regex))
+			{
+				++whitelisted;
+			}
+			else if (matchFilters(itr->second.kicklist, line, player_regex))
+			{
+				++kicked;
+			}
+			else if (matchFilters(itr->second.banlist, line, player_regex))
+			{
+				++banned;
+			}
+			else
+			{
+				++unknown;
+			}
+		}
+		auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+		extension_ptr->console->info("BELogScanner: Filter Benchmark: {0} Lines: {1} Whitelisted: {2} Kicked: {3} Banned: {4} Unknown: {5} Total: {6}ms Lines/sec: {7}", filename, lines.size(), whitelisted, kicked, banned, unknown, (elapsed / 1000), ((static_cast<long long>(lines.size()) * 1000000) / std::max<long long>(1, elapsed)));
 	}
-}
+#endif
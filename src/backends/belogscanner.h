@@ -18,15 +18,22 @@ along with this program. If not, see <http://www.gnu.org/licenses/>.
 
 #pragma once
 
-#include <regex>
+#include <array>
+#include <unordered_map>
+#include <vector>
 
 #include <boost/asio.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/regex.hpp>
+#include <boost/utility/string_ref.hpp>
+
+#ifdef __linux__
+	#include <sys/inotify.h>
+#endif
 
 #include <Poco/DateTime.h>
 #include <Poco/DirectoryWatcher.h>
 #include <Poco/ExpireCache.h>
-#include <Poco/MD5Engine.h>
 
 #include "../abstract_ext.h"
 
@@ -39,14 +46,20 @@ class BELogScanner
 
 		void start(AbstractExt *extension, boost::asio::io_service &io_service);
 		void stop();
+		void release();
 
 		void updateAdd(std::string &steam_id, std::string &value);
 		void updateRemove(std::string &steam_id, std::string &value);
 
+		#if defined(TEST_APP) && defined(DEBUG_TESTING)
+			void benchmarkFilters(AbstractExt *extension, const std::string &path_str);
+		#endif
+
 	protected:
 
 	private:
 		AbstractExt *extension_ptr;
+		bool started = false;
 
 		Poco::DateTime current_dateTime;
 
@@ -55,20 +68,40 @@ class BELogScanner
 
 		boost::asio::io_service *io_service_ptr;
 
-		std::unique_ptr<Poco::DirectoryWatcher> be_directory_watcher;
 		std::unique_ptr<Poco::DirectoryWatcher> filters_directory_watcher;
 
-
-		struct Filter
+		// BattlEye Logs
+		//   Linux: inotify on the Worker Lane, Appended Lines are scanned as soon as BattlEye writes them
+		//   Windows: Poco DirectoryWatcher (ReadDirectoryChangesW)
+		#ifdef __linux__
+			std::unique_ptr<boost::asio::posix::stream_descriptor> inotify_stream;
+			alignas(inotify_event) std::array<char, 8192> inotify_buffer;
+		#else
+			std::unique_ptr<Poco::DirectoryWatcher> be_directory_watcher;
+		#endif
+
+
+		// Filter Lists (whitelist / kicklist / banlist)
+		//   Static Filters are combined into one regex (?:filter1)|(?:filter2)|..., so each line is searched once per list
+		//   Filters with Back References keep their own regex, combining would renumber their groups
+		//   Dynamic Filters ([:player_key:]) are compiled once per Player Key Rule + cached, only recompiled when Player Keys change
+		struct DynamicFilter
 		{
-			std::regex regex;
 			std::string regex_str;
-			bool dynamic_regex = false;
+			std::unordered_map<std::string, boost::regex> regex_cache; // keyed by Player Key Rule
+		};
+
+		struct FilterList
+		{
+			boost::regex combined_regex;
+			bool combined = false;
+			std::vector<boost::regex> separate_regex;
+			std::vector<DynamicFilter> dynamic_filters;
 		};
 
 		struct Spam
 		{
-			std::regex regex;
+			boost::regex regex;
 			std::string regex_str;
 			bool dynamic_regex = false;
 
@@ -81,9 +114,9 @@ class BELogScanner
 
 		struct FilterRules
 		{
-			std::vector<Filter> banlist_regex;
-			std::vector<Filter> kicklist_regex;
-			std::vector<Filter> whitelist_regex;
+			FilterList banlist;
+			FilterList kicklist;
+			FilterList whitelist;
 			std::vector<Spam> spam_rules;
 		};
 		std::unordered_map<std::string, FilterRules> filters_rules;
@@ -104,7 +137,8 @@ class BELogScanner
 
 		struct BELog
 		{
-			std::streamoff f_pos;
+			std::streamoff f_pos = 0;
+			std::string partial_line; // Last Line without a newline yet, completed by the next read
 			LogData log_data;
 
 			std::unique_ptr<boost::asio::deadline_timer> scan_timer;
@@ -113,9 +147,11 @@ class BELogScanner
 			std::shared_ptr<spdlog::logger> ban_logger;
 			std::shared_ptr<spdlog::logger> unknown_logger;
 		};
-		std::unordered_map<std::string, BELog> belogs;
+		std::unordered_map<std::string, BELog> belogs; // keyed by filename (no extension)
 		std::mutex belogs_mutex;
 
+		std::vector<char> read_buffer; // Reused for every read, only appended bytes are read
+
 		struct AddPlayerKey
 		{
 			std::string steam_id;
@@ -129,25 +165,36 @@ class BELogScanner
 			Poco::Timestamp timestamp;
 		};
 
-		Poco::MD5Engine md5;
-
 
 		void loadFilters();
 		void reloadFilters(const Poco::DirectoryWatcher::DirectoryEvent& event);
 
-		void loadRegexFile(std::string &path_str, std::vector<Filter> &filters);
+		void loadRegexFile(std::string &path_str, FilterList &filter_list);
+		bool matchFilters(FilterList &filter_list, const std::string &logged_line, const std::string &player_regex);
+		void logFilterMatch(const std::string &list_name, const std::string &filename, const LogData &log_data);
 		void loadSpamFile(std::string &path_str, std::vector<Spam> &spam_rules);
 
-		void onFileAdded(const Poco::DirectoryWatcher::DirectoryEvent& event);
-		void onFileRemoved(const Poco::DirectoryWatcher::DirectoryEvent& event);
-		void onFileModified(const Poco::DirectoryWatcher::DirectoryEvent& event);
-		void onFileMovedFrom(const Poco::DirectoryWatcher::DirectoryEvent& event);
-		void onFileMovedTo(const Poco::DirectoryWatcher::DirectoryEvent& event);
+		#ifdef __linux__
+			void readInotify();
+			void onInotify(const boost::system::error_code &ec, std::size_t bytes_transferred);
+		#else
+			void onFileAdded(const Poco::DirectoryWatcher::DirectoryEvent& event);
+			void onFileRemoved(const Poco::DirectoryWatcher::DirectoryEvent& event);
+			void onFileModified(const Poco::DirectoryWatcher::DirectoryEvent& event);
+			void onFileMovedFrom(const Poco::DirectoryWatcher::DirectoryEvent& event);
+			void onFileMovedTo(const Poco::DirectoryWatcher::DirectoryEvent& event);
+		#endif
+
+		bool isLogFile(const boost::filesystem::path &path);
+		void addLog(const std::string &path_str);
+		void removeLog(const std::string &path_str);
 
 		void launchProcess();
 		void getBEGUID(std::string &steam_id, std::string &beguid);
 
-		void checkLogData(std::string &filename);
+		void checkLogData(const std::string &filename);
+		void parseLine(BELog &belog, const std::string &filename, boost::string_ref line);
+		bool readLog(BELog &belog, const std::string &filename, const std::string &path_str);
 		void scanLog(std::string path_str);
-		void timerScanLog(const size_t delay, std::string &belog_path);
+		void timerScanLog(const boost::system::error_code &ec, std::string path_str);
 };
\ No newline at end of file
@@ -13,15 +13,13 @@ GNU General Public License for more details.
 
 You should have received a copy of the GNU General Public License
 along with this program. If not, see <http://www.gnu.org/licenses/>.
-
-Code to Convert SteamID -> BEGUID
-From Frank https://gist.github.com/Fank/11127158
-
 */
 
 
 #include "steam.h"
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <thread>
@@ -34,53 +32,204 @@ From Frank https://gist.github.com/Fank/11127158
 #include <Poco/JSON/Object.h>
 #include <Poco/JSON/Parser.h>
 
-#include <Poco/MD5Engine.h>
-#include <Poco/DigestEngine.h>
 
 #include <Poco/Net/HTTPClientSession.h>
 #include <Poco/Net/HTTPRequest.h>
 #include <Poco/Net/HTTPResponse.h>
+#include <Poco/NullStream.h>
 #include <Poco/StreamCopier.h>
 #include <Poco/Path.h>
 #include <Poco/URI.h>
 
 #include <Poco/DateTimeFormatter.h>
+#include <Poco/NumberFormatter.h>
 #include <Poco/NumberParser.h>
 #include <Poco/SharedPtr.h>
 #include <Poco/Thread.h>
+#include <Poco/Timespan.h>
 #include <Poco/Types.h>
 #include <Poco/Exception.h>
 
+#include "../hash.h"
+#include "../tokenizer.h"
 
 
 // --------------------------------------------------------------------------------------
 // --------------------------------------------------------------------------------------
 
-void SteamGet::init(AbstractExt *extension)
+void SteamJSONHandler::reset()
 {
-	extension_ptr = extension;
-	session.reset(new Poco::Net::HTTPClientSession("api.steampowered.com", 80));
+	players.clear();
+	friends.clear();
+	missing_friend_steamids = 0;
+
+	depth = 0;
+	array_depth = -1;
+	array_key.clear();
+	current_key.clear();
+	in_entry = false;
 }
 
 
-void SteamGet::update(std::string &update_path, Poco::Dynamic::Var &var)
+void SteamJSONHandler::startObject()
 {
-	path = update_path;
-	json = &var;
+	++depth;
+	if ((array_depth >= 0) && (depth == (array_depth + 1)))
+	{
+		in_entry = true;
+		player = PlayerBans();
+		friend_has_steamid = false;
+	}
 }
 
 
-int SteamGet::getResponse()
+void SteamJSONHandler::endObject()
 {
-	return response;
+	if (in_entry && (depth == (array_depth + 1)))
+	{
+		in_entry = false;
+		if (array_key == "players")
+		{
+			players.push_back(std::move(player));
+		}
+		else if ((array_key == "friends") && (!friend_has_steamid))
+		{
+			++missing_friend_steamids;
+		}
+	}
+	--depth;
 }
 
 
-void SteamGet::run()
+void SteamJSONHandler::startArray()
+{
+	array_key = current_key;
+	array_depth = depth;
+}
+
+
+void SteamJSONHandler::endArray()
+{
+	array_key.clear();
+	array_depth = -1;
+}
+
+
+void SteamJSONHandler::key(const std::string &k)
+{
+	current_key = k;
+}
+
+
+void SteamJSONHandler::null()
+{
+}
+
+
+void SteamJSONHandler::value(int v)
+{
+	number(v);
+}
+
+
+void SteamJSONHandler::value(unsigned v)
+{
+	number(v);
+}
+
+
+#if defined(POCO_HAVE_INT64)
+	void SteamJSONHandler::value(Poco::Int64 v)
+	{
+		number(v);
+	}
+
+
+	void SteamJSONHandler::value(Poco::UInt64 v)
+	{
+		number(static_cast<Poco::Int64>(v));
+	}
+#endif
+
+
+void SteamJSONHandler::number(Poco::Int64 v)
+{
+	if (in_entry && (depth == (array_depth + 1)) && (array_key == "players"))
+	{
+		if (current_key == "NumberOfVACBans")
+		{
+			player.NumberOfVACBans = static_cast<int>(v);
+			player.has_NumberOfVACBans = true;
+		}
+		else if (current_key == "DaysSinceLastBan")
+		{
+			player.DaysSinceLastBan = static_cast<int>(v);
+			player.has_DaysSinceLastBan = true;
+		}
+	}
+}
+
+
+void SteamJSONHandler::value(const std::string &value)
+{
+	if (in_entry && (depth == (array_depth + 1)))
+	{
+		if ((array_key == "players") && (current_key == "SteamId"))
+		{
+			player.steamID = value;
+			player.has_steamID = true;
+		}
+		else if ((array_key == "friends") && (current_key == "steamid"))
+		{
+			friend_has_steamid = true;
+			if (!value.empty())
+			{
+				friends.push_back(value);
+			}
+		}
+	}
+}
+
+
+void SteamJSONHandler::value(double d)
+{
+}
+
+
+void SteamJSONHandler::value(bool b)
 {
-	Poco::Net::HTTPRequest request(Poco::Net::HTTPRequest::HTTP_GET, path, Poco::Net::HTTPMessage::HTTP_1_1);
-	session->sendRequest(request);
+	if (in_entry && (depth == (array_depth + 1)) && (array_key == "players") && (current_key == "VACBanned"))
+	{
+		player.VACBanned = b;
+		player.has_VACBanned = true;
+	}
+}
+
 
+Poco::Dynamic::Var SteamJSONHandler::asVar() const
+{
+	return Poco::Dynamic::Var(); // Results are in players / friends
+}
+
+
+// --------------------------------------------------------------------------------------
+// --------------------------------------------------------------------------------------
+
+void SteamGet::init(AbstractExt *extension, Steam *steam, const std::string &host, const int port)
+{
+	extension_ptr = extension;
+	steam_ptr = steam;
+	json_handler = new SteamJSONHandler();
+	parser.setHandler(json_handler);
+	session.reset(new Poco::Net::HTTPClientSession(host, port));
+	session->setKeepAlive(true);
+	session->setTimeout(Poco::Timespan(10, 0)); // 10 Seconds
+}
+
+
+int SteamGet::get(const std::string &path)
+// Returns 1 == Success, 0 == HTTP Error, -1 == Error
+{
 	#ifdef DEBUG_TESTING
 		extension_ptr->console->info("{0}", path);
 	#endif
@@ -88,31 +237,65 @@ void SteamGet::run()
 		extension_ptr->logger->info("{0}", path);
 	#endif
 
-	Poco::Net::HTTPResponse res;
-	if (res.getStatus() == Poco::Net::HTTPResponse::HTTP_OK)
+	int response;
+	try
 	{
-		try
+		Poco::Net::HTTPRequest request(Poco::Net::HTTPRequest::HTTP_GET, path, Poco::Net::HTTPMessage::HTTP_1_1);
+		request.setKeepAlive(true);
+		session->sendRequest(request);
+
+		Poco::Net::HTTPResponse res;
+		std::istream &is = session->receiveResponse(res);
+		if (res.getStatus() == Poco::Net::HTTPResponse::HTTP_OK)
 		{
-			std::istream &is = session->receiveResponse(res);
-			*json = parser.parse(is); // Dynamic::Var
+			parser.reset();
+			json_handler->reset();
+			parser.parse(is); // Results are in json_handler
 			response = 1;
 		}
-		catch (Poco::Exception& e)
+		else
 		{
 			#ifdef DEBUG_TESTING
-				extension_ptr->console->error("extDB2: Steam: Parsing Error Message: {0}, URI: {1}", e.displayText(), path);
+				extension_ptr->console->error("extDB2: Steam: HTTP Error: {0}, URI: {1}", res.getStatus(), path);
 			#endif
-			extension_ptr->logger->error("extDB2: Steam: Parsing Error Message: {0}, URI: {1}", e.displayText(), path);
-			response = -1;
+			extension_ptr->logger->error("extDB2: Steam: HTTP Error: {0}, URI: {1}", res.getStatus(), path);
+			response = 0;
 		}
+		// Rest of the Response has to be read before the Connection can be reused
+		Poco::NullOutputStream null_ostr;
+		Poco::StreamCopier::copyStream(is, null_ostr);
 	}
-	else
+	catch (Poco::TimeoutException&)
+	{
+		#ifdef DEBUG_TESTING
+			extension_ptr->console->error("extDB2: Steam: Request Timed Out, URI: {0}", path);
+		#endif
+		extension_ptr->logger->error("extDB2: Steam: Request Timed Out, URI: {0}", path);
+		session->reset(); // Reconnect on next Request
+		response = -1;
+	}
+	catch (Poco::Exception& e)
 	{
 		#ifdef DEBUG_TESTING
-			extension_ptr->console->error("extDB2: Steam: HTTP Error: {0}, URI: {1}", res.getStatus(), path);
+			extension_ptr->console->error("extDB2: Steam: Error Message: {0}, URI: {1}", e.displayText(), path);
 		#endif
-		extension_ptr->logger->error("extDB2: Steam: HTTP Error: {0}, URI: {1}", res.getStatus(), path);
-		response = 0;
+		extension_ptr->logger->error("extDB2: Steam: Error Message: {0}, URI: {1}", e.displayText(), path);
+		session->reset();
+		response = -1;
+	}
+	return response;
+}
+
+
+void SteamGet::run()
+{
+	Steam::SteamRequest request;
+	while (steam_ptr->getRequest(request))
+	{
+		steam_ptr->waitRateLimit();
+
+		int response = get(request.path);
+		steam_ptr->processResponse(request, response, *json_handler);
 	}
 }
 
@@ -146,8 +329,37 @@ void Steam::init(AbstractExt *extension, std::string &extension_path, Poco::Date
 	rconBanSettings.BanDuration = extension_ptr->pConf->getString("VAC.BanDuration", "0");
 	rconBanSettings.BanMessage = extension_ptr->pConf->getString("VAC.BanMessage", "VAC Ban");
 
-	SteamVacBans_Cache.reset(new Poco::ExpireCache<std::string, SteamVACBans>(extension_ptr->pConf->getInt("STEAM.BanCacheTime", 3600000)));
-	SteamFriends_Cache.reset(new Poco::ExpireCache<std::string, SteamFriends>(extension_ptr->pConf->getInt("STEAM.FriendsCacheTime", 3600000)));
+	SteamVacBans_Cache.reset(new Poco::UniqueExpireCache<std::string, SteamVACBans>());
+	SteamFriends_Cache.reset(new Poco::UniqueExpireCache<std::string, SteamFriends>());
+	ban_cache_time = static_cast<Poco::Timestamp::TimeDiff>(extension_ptr->pConf->getInt("STEAM.BanCacheTime", 3600000)) * 1000;
+	friends_cache_time = static_cast<Poco::Timestamp::TimeDiff>(extension_ptr->pConf->getInt("STEAM.FriendsCacheTime", 3600000)) * 1000;
+
+	persistent_cache = extension_ptr->pConf->getBool("Steam.Persistent Cache", false);
+	if (persistent_cache)
+	{
+		boost::filesystem::path persistent_cache_relative_path(extension_path);
+		persistent_cache_relative_path /= "extDB";
+		boost::filesystem::create_directories(persistent_cache_relative_path);
+		persistent_cache_relative_path /= "steam_cache.log";
+		persistent_cache_path = persistent_cache_relative_path.make_preferred().string();
+		loadPersistentCache();
+	}
+
+	// Steam Web API Connections, Host + Port can point to a local stand-in for testing
+	std::string host = extension_ptr->pConf->getString("Steam.API Host", "api.steampowered.com");
+	int port = extension_ptr->pConf->getInt("Steam.API Port", 80);
+	int connections = std::min(std::max(extension_ptr->pConf->getInt("Steam.Connections", 4), 1), 16);
+	for (int i = 0; i < connections; ++i)
+	{
+		steam_gets.push_back(std::unique_ptr<SteamGet>(new SteamGet()));
+		steam_gets.back()->init(extension_ptr, this, host, port);
+		steam_get_threads.push_back(std::unique_ptr<Poco::Thread>(new Poco::Thread()));
+	}
+
+	int requests_per_second = extension_ptr->pConf->getInt("Steam.Requests Per Second", 10);
+	request_interval = std::chrono::milliseconds((requests_per_second > 0) ? (1000 / requests_per_second) : 0);
+	next_request_time = std::chrono::steady_clock::now();
+	load_bans = false;
 
 	if (rconBanSettings.autoBan)
 	{
@@ -180,280 +392,337 @@ void Steam::stop()
 
 
 std::string Steam::convertSteamIDtoBEGUID(const std::string &input_str)
-// From Frank https://gist.github.com/Fank/11127158
-// Modified to use libpoco
 {
-	Poco::Int64 steamID = Poco::NumberParser::parse64(input_str);
-	Poco::Int8 i = 0, parts[8] = { 0 };
+	std::string beguid;
+	Hash::getBEGUID(input_str, beguid);
+	return beguid;
+}
+
 
-	do
+void Steam::queueRequests(std::vector<SteamQuery> &queries)
+// SteamIDs already in Cache aren't requested again, Queries with all SteamIDs cached are saved straight away
+{
+	std::lock_guard<std::mutex> lock(mutex_requests);
+	pending_queries.clear();
+	pending_friends.clear();
+	pending_bans.clear();
+	requests.clear();
+	requests_pos = 0;
+
+	for (auto &query : queries)
 	{
-		parts[i++] = steamID & 0xFFu;
-	} while (steamID >>= 8);
+		std::vector<std::string> steamIDs = query.steamIDs;
+		std::sort(steamIDs.begin(), steamIDs.end());
+		steamIDs.erase(std::unique(steamIDs.begin(), steamIDs.end()), steamIDs.end());
 
-	std::stringstream bestring;
-	bestring << "BE";
-	for (int i = 0; i < sizeof(parts); i++) {
-		bestring << char(parts[i]);
+		const std::size_t index = pending_queries.size();
+		PendingQuery pending_query;
+		for (auto &steamID : steamIDs)
+		{
+			if (query.queryFriends && (!(SteamFriends_Cache->has(steamID))))
+			{
+				pending_friends[steamID].push_back(index);
+				++pending_query.remaining_steamIDs;
+			}
+			if (query.queryVACBans && (!(SteamVacBans_Cache->has(steamID))))
+			{
+				pending_bans[steamID].push_back(index);
+				++pending_query.remaining_steamIDs;
+			}
+		}
+		if (pending_query.remaining_steamIDs == 0)
+		{
+			saveQueryResult(query);
+		}
+		pending_query.query = std::move(query);
+		pending_queries.push_back(std::move(pending_query));
 	}
 
-	std::lock_guard<std::mutex> lock(mutex_md5);
-	md5.update(bestring.str());
-	return Poco::DigestEngine::digestToHex(md5.digest());
-}
-
-
-std::vector<std::string> Steam::generateSteamIDStrings(std::vector<std::string> &steamIDs)
-// Steam Only Allows 100 SteamIDs at a time
-{
-	std::string steamIDs_str;
-	std::vector<std::string> steamIDs_list;
+	for (auto &pending_friend : pending_friends)
+	{
+		SteamRequest request;
+		request.friends = true;
+		request.path = "/ISteamUser/GetFriendList/v0001/?key=" + STEAM_api_key + "&relationship=friend&format=json&steamid=" + pending_friend.first;
+		request.steamIDs.push_back(pending_friend.first);
+		requests.push_back(std::move(request));
+	}
 
-	int counter = 0;
-	for (auto &val: steamIDs)
+	// Steam Only Allows 100 SteamIDs at a time
+	SteamRequest request;
+	request.friends = false;
+	for (auto &pending_ban : pending_bans)
+	{
+		request.steamIDs.push_back(pending_ban.first);
+		if (request.steamIDs.size() == 100)
+		{
+			requests.push_back(std::move(request));
+			request = SteamRequest();
+			request.friends = false;
+		}
+	}
+	if (!request.steamIDs.empty())
+	{
+		requests.push_back(std::move(request));
+	}
+	for (auto &ban_request : requests)
 	{
-		if (counter == 100)
+		if (!ban_request.friends)
 		{
-			steamIDs_str.erase(steamIDs_str.begin());
+			std::string steamIDs_str;
+			for (auto &steamID : ban_request.steamIDs)
+			{
+				steamIDs_str += steamID + ",";
+			}
 			steamIDs_str.pop_back();
-			steamIDs_list.push_back(steamIDs_str);
-
-			steamIDs_str.clear();
-			counter = 0;
+			ban_request.path = "/ISteamUser/GetPlayerBans/v1/?key=" + STEAM_api_key + "&format=json&steamids=" + steamIDs_str;
 		}
-		++counter;
-		steamIDs_str += val + ",";
 	}
+}
 
-	if (!steamIDs_str.empty())
+
+bool Steam::getRequest(SteamRequest &request)
+{
+	std::lock_guard<std::mutex> lock(mutex_requests);
+	if (requests_pos < requests.size())
 	{
-		steamIDs_str.pop_back();
-		steamIDs_list.push_back(std::move(steamIDs_str));
+		request = requests[requests_pos];
+		++requests_pos;
+		return true;
 	}
-	return steamIDs_list;
+	return false;
 }
 
 
-void Steam::updateSteamBans(std::vector<std::string> &steamIDs)
+void Steam::waitRateLimit()
 {
-	bool loadBans = false;
+	std::chrono::steady_clock::time_point request_time;
+	{
+		std::lock_guard<std::mutex> lock(mutex_rate_limit);
+		request_time = std::max(std::chrono::steady_clock::now(), next_request_time);
+		next_request_time = request_time + request_interval;
+	}
+	std::this_thread::sleep_until(request_time);
+}
 
-	// Lose Duplicate steamIDs for Steam WEB API Query
-	std::sort(steamIDs.begin(), steamIDs.end());
-	auto last = std::unique(steamIDs.begin(), steamIDs.end());
-	steamIDs.erase(last, steamIDs.end());
 
-	std::vector<std::string> update_steamIDs;
-	for (auto &steamID: steamIDs)
+void Steam::processResponse(const SteamRequest &request, const int response, const SteamJSONHandler &json_handler)
+{
+	if (response == 1)
 	{
-		if (!(SteamVacBans_Cache->has(steamID)))
+		const Poco::Timestamp fetched;
+		const std::string fetched_str = Poco::NumberFormatter::format(static_cast<Poco::Int64>(fetched.epochTime()));
+		std::string persistent_cache_lines;
+		if (request.friends)
 		{
-			update_steamIDs.push_back(steamID);
+			SteamFriends steam_info;
+			steam_info.steamID = request.steamIDs[0];
+			steam_info.expiration = fetched + friends_cache_time;
+			steam_info.friends = json_handler.friends;
+			for (int i = 0; i < json_handler.missing_friend_steamids; ++i)
+			{
+				#ifdef DEBUG_TESTING
+					extension_ptr->console->error("extDB2: Steam: Missing steamid for friend");
+				#endif
+				extension_ptr->logger->error("extDB2: Steam: Missing steamid for friend");
+			}
+			if (persistent_cache)
+			{
+				persistent_cache_lines = "F\t" + steam_info.steamID + "\t" + fetched_str + "\t" + boost::algorithm::join(steam_info.friends, ",") + "\n";
+			}
+			SteamFriends_Cache->add(steam_info.steamID, steam_info);
 		}
-	}
-
-	Poco::Thread steam_thread;
-	std::vector<std::string> steamIDStrings = generateSteamIDStrings(update_steamIDs);
-	for (auto &steamIDString: steamIDStrings)
-	{
-		std::string query = "/ISteamUser/GetPlayerBans/v1/?key=" + STEAM_api_key + "&format=json&steamids=" + steamIDString;
-
-		Poco::Dynamic::Var json;
-		steam_get.update(query, json);
-		steam_thread.start(steam_get);
-		try
+		else
 		{
-			steam_thread.join(10000); // 10 Seconds
-			switch (steam_get.getResponse())
+			for (const auto &player : json_handler.players)
 			{
-				case 1:
-				// SUCCESS STEAM QUERY
+				SteamVACBans steam_info;
+				steam_info.expiration = fetched + ban_cache_time;
+				steam_info.steamID = player.steamID;
+				steam_info.NumberOfVACBans = player.NumberOfVACBans;
+				steam_info.VACBanned = player.VACBanned;
+				steam_info.DaysSinceLastBan = player.DaysSinceLastBan;
+				if (!player.has_steamID)
+				{
+					#ifdef DEBUG_TESTING
+						extension_ptr->console->error("extDB2: Steam: Missing SteamId for playerinfo");
+					#endif
+					extension_ptr->logger->error("extDB2: Steam: Missing SteamId for playerinfo");
+				}
+				if (!player.has_NumberOfVACBans)
+				{
+					#ifdef DEBUG_TESTING
+						extension_ptr->console->error("extDB2: Steam: Missing NumberOfVACBans for playerinfo");
+					#endif
+					extension_ptr->logger->error("extDB2: Steam: Missing NumberOfVACBans for playerinfo");
+				}
+				if (!player.has_VACBanned)
+				{
+					#ifdef DEBUG_TESTING
+						extension_ptr->console->error("extDB2: Steam: Missing VACBanned for playerinfo");
+					#endif
+					extension_ptr->logger->error("extDB2: Steam: Missing VACBanned for playerinfo");
+				}
+				if (!player.has_DaysSinceLastBan)
+				{
+					#ifdef DEBUG_TESTING
+						extension_ptr->console->error("extDB2: Steam: Missing DaysSinceLastBan for playerinfo");
+					#endif
+					extension_ptr->logger->error("extDB2: Steam: Missing DaysSinceLastBan for playerinfo");
+				}
+
+				#ifdef DEBUG_TESTING
+					extension_ptr->console->info();
+					extension_ptr->console->info("VAC Bans Info: SteamId {0}", steam_info.steamID);
+					extension_ptr->console->info("VAC Bans Info: NumberOfVACBans {0}", steam_info.NumberOfVACBans);
+					extension_ptr->console->info("VAC Bans Info: VACBanned {0}", steam_info.VACBanned);
+					extension_ptr->console->info("VAC Bans Info: DaysSinceLastBan {0}", steam_info.DaysSinceLastBan);
+				#endif
+
+				if ((steam_info.NumberOfVACBans >= rconBanSettings.NumberOfVACBans) && (steam_info.DaysSinceLastBan <= rconBanSettings.DaysSinceLastBan))
+				{
+					steam_info.extDBBanned = true;
+					if ((extension_ptr->ext_connectors_info.rcon) && rconBanSettings.autoBan)
 					{
-						Poco::JSON::Object::Ptr json_object = json.extract<Poco::JSON::Object::Ptr>();
-						for (const auto &val : *(json_object->getArray("players")))
-						{
-							Poco::JSON::Object::Ptr sub_json_object = val.extract<Poco::JSON::Object::Ptr>();
-							SteamVACBans steam_info;
-							//SteamId
-							if (sub_json_object->has("SteamId"))
-							{
-								steam_info.steamID = sub_json_object->getValue<std::string>("SteamId");
-							}
-							else
-							{
-								steam_info.steamID = "";
-								#ifdef DEBUG_TESTING
-									extension_ptr->console->error("extDB2: Steam: Missing SteamId for playerinfo");
-								#endif
-								extension_ptr->logger->error("extDB2: Steam: Missing SteamId for playerinfo");
-							}
-							//NumberOfVACBans
-							if (sub_json_object->has("NumberOfVACBans"))
-							{
-								steam_info.NumberOfVACBans = sub_json_object->getValue<int>("NumberOfVACBans");
-							}
-							else
-							{
-								steam_info.NumberOfVACBans = 0;
-								#ifdef DEBUG_TESTING
-									extension_ptr->console->error("extDB2: Steam: Missing NumberOfVACBans for playerinfo");
-								#endif
-								extension_ptr->logger->error("extDB2: Steam: Missing NumberOfVACBans for playerinfo");
-							}
-							//VACBanned
-							if (sub_json_object->has("VACBanned"))
-							{
-								steam_info.VACBanned = sub_json_object->getValue<bool>("VACBanned");
-							}
-							else
-							{
-								steam_info.VACBanned = false;
-								#ifdef DEBUG_TESTING
-									extension_ptr->console->error("extDB2: Steam: Missing VACBanned for playerinfo");
-								#endif
-								extension_ptr->logger->error("extDB2: Steam: Missing VACBanned for playerinfo");
-							}
-							//DaysSinceLastBan
-							if (sub_json_object->has("DaysSinceLastBan"))
-							{
-								steam_info.DaysSinceLastBan = sub_json_object->getValue<int>("DaysSinceLastBan");
-							}
-							else
-							{
-								steam_info.DaysSinceLastBan = 0;
-								#ifdef DEBUG_TESTING
-									extension_ptr->console->error("extDB2: Steam: Missing DaysSinceLastBan for playerinfo");
-								#endif
-								extension_ptr->logger->error("extDB2: Steam: Missing DaysSinceLastBan for playerinfo");
-							}
-
-							#ifdef DEBUG_TESTING
-								extension_ptr->console->info();
-								extension_ptr->console->info("VAC Bans Info: SteamId {0}", steam_info.steamID);
-								extension_ptr->console->info("VAC Bans Info: NumberOfVACBans {0}", steam_info.NumberOfVACBans);
-								extension_ptr->console->info("VAC Bans Info: VACBanned {0}", steam_info.VACBanned);
-								extension_ptr->console->info("VAC Bans Info: DaysSinceLastBan {0}", steam_info.DaysSinceLastBan);
-							#endif
-
-							if ((steam_info.NumberOfVACBans >= rconBanSettings.NumberOfVACBans) && (steam_info.DaysSinceLastBan <= rconBanSettings.DaysSinceLastBan))
-							{
-								steam_info.extDBBanned = true;
-								if ((extension_ptr->ext_connectors_info.rcon) && rconBanSettings.autoBan)
-								{
-									if (extension_ptr->vacBans_logger)
-									{
-										initBanslogger();
-									}
-									std::string beguid = convertSteamIDtoBEGUID(steam_info.steamID);
-									extension_ptr->rconCommand("addBan " + beguid + " " + rconBanSettings.BanDuration + " " + rconBanSettings.BanMessage);
-									extension_ptr->vacBans_logger->warn("Banned: {0}, BEGUID: {1}, Duration: {2}, Ban Message: {3}", steam_info.steamID, beguid, rconBanSettings.BanDuration, rconBanSettings.BanMessage);
-									loadBans = true;
-								}
-							}
-							SteamVacBans_Cache->add(steam_info.steamID, steam_info);
-						}
+						std::string beguid = convertSteamIDtoBEGUID(steam_info.steamID);
+						extension_ptr->rconCommand("addBan " + beguid + " " + rconBanSettings.BanDuration + " " + rconBanSettings.BanMessage);
+						extension_ptr->vacBans_logger->warn("Banned: {0}, BEGUID: {1}, Duration: {2}, Ban Message: {3}", steam_info.steamID, beguid, rconBanSettings.BanDuration, rconBanSettings.BanMessage);
+						load_bans = true;
 					}
-					break;
-				case 0:
-					// HTTP ERROR
-					break;
-				case -1:
-					// ERROR STEAM QUERY
-					break;
+				}
+				if (persistent_cache)
+				{
+					persistent_cache_lines += "B\t" + steam_info.steamID + "\t" + fetched_str + "\t" + Poco::NumberFormatter::format(steam_info.NumberOfVACBans) + "\t" + Poco::NumberFormatter::format(steam_info.DaysSinceLastBan) + "\t" + (steam_info.VACBanned ? "1" : "0") + "\n";
+				}
+				SteamVacBans_Cache->add(steam_info.steamID, steam_info);
 			}
 		}
-		catch (Poco::TimeoutException&)
+		if (!persistent_cache_lines.empty())
 		{
-			steam_get.abort();
-			steam_thread.join();
-			#ifdef DEBUG_TESTING
-				extension_ptr->console->error("extDB2: Steam: Request Timed Out");
-			#endif
-			extension_ptr->logger->error("extDB2: Steam: Request Timed Out");
+			appendPersistentCache(persistent_cache_lines);
 		}
 	}
-	if (loadBans)
+
+	// Failed Requests also count as done, Results for their SteamIDs are [] / false
+	std::lock_guard<std::mutex> lock(mutex_requests);
+	auto &pending_steamIDs = request.friends ? pending_friends : pending_bans;
+	for (auto &steamID : request.steamIDs)
 	{
-		extension_ptr->rconCommand("loadBans");
+		auto itr = pending_steamIDs.find(steamID);
+		if (itr != pending_steamIDs.end())
+		{
+			for (auto &index : itr->second)
+			{
+				--(pending_queries[index].remaining_steamIDs);
+				if (pending_queries[index].remaining_steamIDs == 0)
+				{
+					saveQueryResult(pending_queries[index].query);
+				}
+			}
+			pending_steamIDs.erase(itr);
+		}
 	}
 }
 
 
-void Steam::updateSteamFriends(std::vector<std::string> &steamIDs)
+void Steam::loadPersistentCache()
+// Latest Entry per SteamID wins, expired Entries are dropped + file is rewritten with only the Entries still valid
 {
-	// Lose Duplicate steamIDs for Steam WEB API Query
-	std::sort(steamIDs.begin(), steamIDs.end());
-	auto last = std::unique(steamIDs.begin(), steamIDs.end());
-	steamIDs.erase(last, steamIDs.end());
-
-	std::vector<std::string> update_steamIDs;
-	for (auto &steamID: steamIDs)
+	std::unordered_map<std::string, std::string> ban_lines;
+	std::unordered_map<std::string, std::string> friends_lines;
+	const Poco::Timestamp now;
+	int loaded = 0;
 	{
-		if (!(SteamVacBans_Cache->has(steamID)))
+		std::ifstream persistent_cache_istr(persistent_cache_path);
+		std::string line;
+		std::vector<boost::string_ref> tokens;
+		while (std::getline(persistent_cache_istr, line))
 		{
-			update_steamIDs.push_back(steamID);
-		}
-	}
-
-	Poco::Thread steam_thread;
-	for (auto &steamID: update_steamIDs)
-	{
-		std::string query = "/ISteamUser/GetFriendList/v0001/?key=" + STEAM_api_key + "&relationship=friend&format=json&steamid=" + steamID;
+			Tokenizer::split(line, '\t', tokens);
+			if (tokens.size() < 3)
+			{
+				continue;
+			}
+			Poco::Int64 fetched_time;
+			if (!(Poco::NumberParser::tryParse64(tokens[2].to_string(), fetched_time)))
+			{
+				continue;
+			}
+			const Poco::Timestamp fetched = Poco::Timestamp::fromEpochTime(static_cast<std::time_t>(fetched_time));
+			const std::string steamID = tokens[1].to_string();
 
-		Poco::Dynamic::Var json;
-		steam_get.update(query, json);
-		steam_thread.start(steam_get);
-		try
-		{
-			steam_thread.join(10000); // 10 Seconds
-			switch (steam_get.getResponse())
+			if ((tokens[0] == "B") && (tokens.size() == 6))
+			{
+				SteamVACBans steam_info;
+				steam_info.steamID = steamID;
+				steam_info.expiration = fetched + ban_cache_time;
+				if ((steam_info.expiration <= now) || (!(Poco::NumberParser::tryParse(tokens[3].to_string(), steam_info.NumberOfVACBans))) || (!(Poco::NumberParser::tryParse(tokens[4].to_string(), steam_info.DaysSinceLastBan))))
+				{
+					continue;
+				}
+				steam_info.VACBanned = (tokens[5] == "1");
+				// VAC Settings can change between restarts
+				steam_info.extDBBanned = ((steam_info.NumberOfVACBans >= rconBanSettings.NumberOfVACBans) && (steam_info.DaysSinceLastBan <= rconBanSettings.DaysSinceLastBan));
+				SteamVacBans_Cache->add(steamID, steam_info);
+				ban_lines[steamID] = line;
+			}
+			else if ((tokens[0] == "F") && (tokens.size() == 4))
 			{
-				case 1:
-					// SUCCESS STEAM QUERY
+				SteamFriends steam_info;
+				steam_info.steamID = steamID;
+				steam_info.expiration = fetched + friends_cache_time;
+				if (steam_info.expiration <= now)
+				{
+					continue;
+				}
+				if (!(tokens[3].empty()))
+				{
+					std::vector<boost::string_ref> friends_tokens;
+					Tokenizer::split(tokens[3], ',', friends_tokens);
+					for (auto &friend_token : friends_tokens)
 					{
-						Poco::JSON::Object::Ptr json_object = json.extract<Poco::JSON::Object::Ptr>();
-						SteamFriends steam_info;
-						std::string friendsteamID;
-						for (const auto &val : *(json_object->getObject("friendslist")->getArray("friends")))
-						{
-							Poco::JSON::Object::Ptr sub_json_object = val.extract<Poco::JSON::Object::Ptr>();
-							if (sub_json_object->has("steamid"))
-							{
-								friendsteamID = sub_json_object->getValue<std::string>("steamid"); // TODO Default Value
-								if (!friendsteamID.empty())
-								{
-									steam_info.friends.push_back(friendsteamID);
-								}
-							}
-							else
-							{
-								#ifdef DEBUG_TESTING
-									extension_ptr->console->error("extDB2: Steam: Missing steamid for friend");
-								#endif
-								extension_ptr->logger->error("extDB2: Steam: Missing steamid for friend");
-							}
-						}
-						SteamFriends_Cache->add(steamID, steam_info);
+						steam_info.friends.push_back(friend_token.to_string());
 					}
-					break;
-				case 0:
-					// HTTP ERROR
-					break;
-				case -1:
-					// ERROR STEAM QUERY
-					break;
+				}
+				SteamFriends_Cache->add(steamID, steam_info);
+				friends_lines[steamID] = line;
 			}
 		}
-		catch (Poco::TimeoutException&)
+	}
+
+	// Compact
+	const std::string temp_path = persistent_cache_path + ".tmp";
+	{
+		std::ofstream persistent_cache_ostr(temp_path, std::ios::trunc);
+		for (auto &ban_line : ban_lines)
 		{
-			steam_get.abort();
-			steam_thread.join();
-			#ifdef DEBUG_TESTING
-				extension_ptr->console->error("extDB2: Steam: Request Timed Out");
-			#endif
-			extension_ptr->logger->error("extDB2: Steam: Request Timed Out");
+			persistent_cache_ostr << ban_line.second << "\n";
+			++loaded;
+		}
+		for (auto &friends_line : friends_lines)
+		{
+			persistent_cache_ostr << friends_line.second << "\n";
+			++loaded;
 		}
 	}
+	boost::system::error_code ec;
+	boost::filesystem::rename(temp_path, persistent_cache_path, ec);
+	if (ec)
+	{
+		#ifdef DEBUG_TESTING
+			extension_ptr->console->error("extDB2: Steam: Persistent Cache Error: {0}", ec.message());
+		#endif
+		extension_ptr->logger->error("extDB2: Steam: Persistent Cache Error: {0}", ec.message());
+	}
+	persistent_cache_file.open(persistent_cache_path, std::ios::app);
+	extension_ptr->logger->info("extDB2: Steam: Persistent Cache Loaded: {0} Entries", loaded);
+}
+
+
+void Steam::appendPersistentCache(const std::string &lines)
+{
+	std::lock_guard<std::mutex> lock(mutex_persistent_cache);
+	persistent_cache_file << lines;
+	persistent_cache_file.flush();
 }
 
 
@@ -481,12 +750,9 @@ void Steam::addQuery(const unsigned int &unique_id, bool queryFriends, bool quer
 
 void Steam::run()
 {
-	std::string result;
 	std::vector<SteamQuery> query_queue_copy;
-	Poco::SharedPtr<SteamFriends> friends_info;
-	Poco::SharedPtr<SteamVACBans> vac_info;
 
-	steam_get.init(extension_ptr);
+	initBanslogger(); // Before SteamGet Threads can Auto Ban
 	*steam_run_flag = true;
 	while (*steam_run_flag)
 	{
@@ -502,98 +768,166 @@ void Steam::run()
 
 		{
 			std::lock_guard<std::mutex> lock(mutex_query_queue);
-			query_queue_copy = query_queue;
+			query_queue_copy.swap(query_queue);
 			query_queue.clear();
 		}
 
 		if (!query_queue_copy.empty())
 		{
-			std::vector<std::string> steamIDs_friends;
-			std::vector<std::string> steamIDs_bans;
+			queueRequests(query_queue_copy);
+			query_queue_copy.clear();
+
+			std::size_t num_of_requests;
+			{
+				std::lock_guard<std::mutex> lock(mutex_requests);
+				num_of_requests = requests.size();
+			}
+			const std::size_t num_of_threads = std::min(num_of_requests, steam_gets.size());
+			for (std::size_t i = 0; i < num_of_threads; ++i)
+			{
+				steam_get_threads[i]->start(*steam_gets[i]);
+			}
+			for (std::size_t i = 0; i < num_of_threads; ++i)
+			{
+				steam_get_threads[i]->join();
+			}
 
-			for (auto &val: query_queue_copy)
+			if (load_bans.exchange(false))
+			{
+				extension_ptr->rconCommand("loadBans");
+			}
+		}
+	}
+}
+
+
+void Steam::saveQueryResult(const SteamQuery &query)
+{
+	if (query.unique_id <= 1)
+	{
+		return;
+	}
+
+	std::string result;
+	if (query.queryFriends)
+	{
+		Poco::SharedPtr<SteamFriends> friends_info;
+		for (auto &steamID: query.steamIDs)
+		{
+			friends_info = SteamFriends_Cache->get(steamID);
+			if (friends_info.isNull())
+			{
+				result += "[],";
+				#ifdef DEBUG_TESTING
+					extension_ptr->console->error("extDB2: Steam: No Friends Entry for: {0}", steamID);
+				#endif
+				#ifdef DEBUG_LOGGING
+					extension_ptr->logger->warn("extDB2: Steam: No Friends Entry for: {0}", steamID);
+				#endif
+			}
+			else
 			{
-				if (val.queryFriends)
+				for (auto &friendSteamID: friends_info->friends)
 				{
-					steamIDs_friends.insert(steamIDs_friends.end(), val.steamIDs.begin(), val.steamIDs.end());
+					result += "\"" + friendSteamID + "\",";
 				}
-				if (val.queryVACBans)
+			}
+		}
+	}
+	else if (query.queryVACBans)
+	{
+		Poco::SharedPtr<SteamVACBans> vac_info;
+		for (auto &steamID : query.steamIDs)
+		{
+			vac_info = SteamVacBans_Cache->get(steamID);
+			if (vac_info.isNull()) // Incase entry expired
+			{
+				result += "false,";
+				#ifdef DEBUG_TESTING
+					extension_ptr->console->error("extDB2: Steam: No Bans Entry for: {0}", steamID);
+				#endif
+				#ifdef DEBUG_LOGGING
+					extension_ptr->logger->warn("extDB2: Steam: No Bans Entry for: {0}", steamID);
+				#endif
+			}
+			else
+			{
+				if (vac_info->extDBBanned)
 				{
-					steamIDs_bans.insert(steamIDs_bans.end(), val.steamIDs.begin(), val.steamIDs.end());
+					result += "true,";
+				}
+				else
+				{
+					result += "false,";
 				}
 			}
+		}
+	}
+	if (!result.empty())
+	{
+		result.pop_back();
+	}
+	AbstractExt::resultData result_data;
+	result_data.message = "[1,[" + result + "]]";
+	extension_ptr->saveResult_mutexlock(query.unique_id, result_data);
+}
 
-			updateSteamFriends(steamIDs_friends);
-			updateSteamBans(steamIDs_bans);
 
-			result.clear();
-			for (auto &val: query_queue_copy)
+#if defined(TEST_APP) && defined(DEBUG_TESTING)
+	extern std::atomic<std::size_t> allocation_counter; // memory_allocator.cpp
+	extern std::atomic<std::size_t> allocation_bytes_live;
+	extern std::atomic<std::size_t> allocation_bytes_peak;
+
+	void Steam::benchmarkJSON(const std::string &path_str)
+	// Recorded GetPlayerBans / GetFriendList Response, Poco::Dynamic::Var DOM vs SteamJSONHandler
+	//   Peak Bytes == most Heap in use above what was in use before parsing
+	{
+		std::string json_str;
+		{
+			std::ifstream json_istr(path_str, std::ios::binary);
+			json_str.assign(std::istreambuf_iterator<char>(json_istr), std::istreambuf_iterator<char>());
+		}
+		if (json_str.empty())
+		{
+			extension_ptr->console->warn("extDB2: Steam JSON Benchmark: Empty / Missing File: {0}", path_str);
+			return;
+		}
+
+		const int iterations = 100;
+		Poco::JSON::Parser dom_parser;
+		Poco::JSON::Parser sax_parser;
+		Poco::SharedPtr<SteamJSONHandler> json_handler(new SteamJSONHandler());
+		sax_parser.setHandler(json_handler);
+
+		for (bool dom : {true, false})
+		{
+			long long elapsed = 0;
+			std::size_t allocations = 0;
+			std::size_t peak_bytes = 0;
+			for (int i = 0; i < iterations; ++i)
 			{
-				if (val.unique_id > 1)
+				const std::size_t allocations_start = allocation_counter.load();
+				const std::size_t bytes_start = allocation_bytes_live.load();
+				allocation_bytes_peak = bytes_start;
+				auto start = std::chrono::high_resolution_clock::now();
+				if (dom)
 				{
-					result.clear();
-					if (val.queryFriends)
-					{
-						for (auto &steamID: val.steamIDs)
-						{
-							friends_info = SteamFriends_Cache->get(steamID);
-							if (friends_info.isNull())
-							{
-								result += "[],";
-								#ifdef DEBUG_TESTING
-									extension_ptr->console->error("extDB2: Steam: No Friends Entry for: {0}", steamID);
-								#endif
-								#ifdef DEBUG_LOGGING
-									extension_ptr->logger->warn("extDB2: Steam: No Friends Entry for: {0}", steamID);
-								#endif
-							}
-							else
-							{
-								for (auto &friendSteamID: friends_info->friends)
-								{
-									result += "\"" + friendSteamID + "\",";
-								}
-							}
-						}
-					}
-					else if (val.queryVACBans)
-					{
-						for (auto &steamID : val.steamIDs)
-						{
-							vac_info = SteamVacBans_Cache->get(steamID);
-							if (vac_info.isNull()) // Incase entry expired
-							{
-								result += "false,";
-								#ifdef DEBUG_TESTING
-									extension_ptr->console->error("extDB2: Steam: No Bans Entry for: {0}", steamID);
-								#endif
-								#ifdef DEBUG_LOGGING
-									extension_ptr->logger->warn("extDB2: Steam: No Bans Entry for: {0}", steamID);
-								#endif
-							}
-							else
-							{
-								if (vac_info->extDBBanned)
-								{
-									result += "true,";
-								}
-								else
-								{
-									result += "false,";
-								}
-							}
-						}
-					}
-					if (!result.empty())
-					{
-						result.pop_back();
-					}
-					result = "[1,[" + result + "]]";
-					AbstractExt::resultData result_data;
-					result_data.message = std::move(result);
-					extension_ptr->saveResult_mutexlock(val.unique_id, result_data);
+					dom_parser.reset();
+					Poco::Dynamic::Var json = dom_parser.parse(json_str);
+					peak_bytes = std::max(peak_bytes, (allocation_bytes_peak.load() - bytes_start));
+				}
+				else
+				{
+					sax_parser.reset();
+					json_handler->reset();
+					sax_parser.parse(json_str);
+					peak_bytes = std::max(peak_bytes, (allocation_bytes_peak.load() - bytes_start));
 				}
+				elapsed += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+				allocations += allocation_counter.load() - allocations_start;
 			}
+			extension_ptr->console->info("extDB2: Steam JSON Benchmark: {0} Size: {1} bytes Parse: {2}us Allocations: {3} Peak: {4} bytes", (dom ? "DOM" : "Streaming"), json_str.size(), (elapsed / iterations), (allocations / iterations), peak_bytes);
 		}
+		extension_ptr->console->info("extDB2: Steam JSON Benchmark: Streaming found Players: {0} Friends: {1}", json_handler->players.size(), json_handler->friends.size());
 	}
-}
+#endif
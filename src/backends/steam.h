@@ -18,50 +18,115 @@ along with this program. If not, see <http://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <mutex>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "Poco/Dynamic/Var.h"
+#include "Poco/JSON/Handler.h"
 #include "Poco/JSON/Parser.h"
 
-#include <Poco/MD5Engine.h>
 #include <Poco/DigestEngine.h>
 
 #include <Poco/AbstractCache.h>
 #include <Poco/DateTime.h>
-#include <Poco/ExpireCache.h>
+#include <Poco/SharedPtr.h>
+#include <Poco/Thread.h>
+#include <Poco/Timestamp.h>
+#include <Poco/UniqueExpireCache.h>
 
 #include <Poco/Net/HTTPClientSession.h>
 
 #include "../abstract_ext.h"
 
 
+class Steam;
+
+
+class SteamJSONHandler: public Poco::JSON::Handler
+// Streaming Handler for GetPlayerBans + GetFriendList Responses
+//   Only the needed fields are kept as they are parsed, no Poco::Dynamic::Var DOM is built
+{
+	public:
+		struct PlayerBans
+		{
+			std::string steamID;
+			int NumberOfVACBans = 0;
+			int DaysSinceLastBan = 0;
+			bool VACBanned = false;
+
+			bool has_steamID = false;
+			bool has_NumberOfVACBans = false;
+			bool has_DaysSinceLastBan = false;
+			bool has_VACBanned = false;
+		};
+
+		std::vector<PlayerBans> players; // "players" : [{...}, ...]
+		std::vector<std::string> friends; // "friendslist" : {"friends" : [{"steamid" : ...}, ...]}
+		int missing_friend_steamids;
+
+		void reset();
+
+		void startObject();
+		void endObject();
+		void startArray();
+		void endArray();
+		void key(const std::string &k);
+
+		void null();
+		void value(int v);
+		void value(unsigned v);
+		#if defined(POCO_HAVE_INT64)
+			void value(Poco::Int64 v);
+			void value(Poco::UInt64 v);
+		#endif
+		void value(const std::string &value);
+		void value(double d);
+		void value(bool b);
+
+		Poco::Dynamic::Var asVar() const;
+
+	private:
+		int depth = 0;
+		int array_depth = -1; // Entries are Objects directly inside an Array
+		std::string array_key;
+		std::string current_key;
+
+		bool in_entry = false;
+		PlayerBans player;
+		bool friend_has_steamid = false;
+
+		void number(Poco::Int64 v);
+};
+
+
 class SteamGet: public Poco::Runnable
+// One Keep-Alive Connection to Steam Web API, fetches Steam Requests until none are left
 {
 	public:
-		void init(AbstractExt *extension);
+		void init(AbstractExt *extension, Steam *steam, const std::string &host, const int port);
 
 		void run();
 		void stop();
 
 		void abort();
 
-		void update(std::string &update_path, Poco::Dynamic::Var &var);
-		int getResponse();
+		int get(const std::string &path);
 
 	private:
 		AbstractExt *extension_ptr;
-
-		std::string path;
-		std::string steam_api_key;
+		Steam *steam_ptr;
 
 		std::unique_ptr<Poco::Net::HTTPClientSession> session;
 
-		Poco::Dynamic::Var *json;
 		Poco::JSON::Parser parser;
-
-		int response=-1;
+		Poco::SharedPtr<SteamJSONHandler> json_handler;
 };
 
 
@@ -75,9 +140,26 @@ class Steam: public Poco::Runnable
 		void initBanslogger();
 		void addQuery(const unsigned int &unique_id, bool queryFriends, bool queryVacBans, std::vector<std::string> &steamIDs);
 
+		struct SteamRequest
+		{
+			bool friends; // GetFriendList (1 SteamID) else GetPlayerBans (<= 100 SteamIDs)
+			std::string path;
+			std::vector<std::string> steamIDs;
+		};
+
+		// Called by SteamGet Threads
+		bool getRequest(SteamRequest &request);
+		void waitRateLimit();
+		void processResponse(const SteamRequest &request, const int response, const SteamJSONHandler &json_handler);
+
+		#if defined(TEST_APP) && defined(DEBUG_TESTING)
+			void benchmarkJSON(const std::string &path_str);
+		#endif
+
 	private:
 		AbstractExt *extension_ptr;
 
+		// Cache Entries expire individually, Entries loaded from Persistent Cache keep their original fetched time
 		struct SteamVACBans
 		{
 			int NumberOfVACBans;
@@ -86,12 +168,18 @@ class Steam: public Poco::Runnable
 
 			bool extDBBanned=false;
 			bool VACBanned;
+
+			Poco::Timestamp expiration;
+			const Poco::Timestamp &getExpiration() const { return expiration; };
 		};
 
 		struct SteamFriends
 		{
 			std::string steamID;
 			std::vector<std::string> friends;
+
+			Poco::Timestamp expiration;
+			const Poco::Timestamp &getExpiration() const { return expiration; };
 		};
 
 		struct SteamQuery
@@ -117,20 +205,54 @@ class Steam: public Poco::Runnable
 
 		std::string STEAM_api_key;
 		RConBan rconBanSettings;
-		std::unique_ptr<Poco::ExpireCache<std::string, SteamVACBans> > SteamVacBans_Cache; // 1 Hour (3600000)
-		std::unique_ptr<Poco::ExpireCache<std::string, SteamFriends> > SteamFriends_Cache; // 1 Hour (3600000)
+		std::unique_ptr<Poco::UniqueExpireCache<std::string, SteamVACBans> > SteamVacBans_Cache;
+		std::unique_ptr<Poco::UniqueExpireCache<std::string, SteamFriends> > SteamFriends_Cache;
+		Poco::Timestamp::TimeDiff ban_cache_time; // 1 Hour (3600000 ms)
+		Poco::Timestamp::TimeDiff friends_cache_time; // 1 Hour (3600000 ms)
+
+		// Persistent Cache
+		//   Append-Only Log of fetched Entries (extDB/steam_cache.log), loaded + compacted at startup
+		//   B<TAB>SteamID<TAB>Fetched<TAB>NumberOfVACBans<TAB>DaysSinceLastBan<TAB>VACBanned
+		//   F<TAB>SteamID<TAB>Fetched<TAB>Friend SteamID,Friend SteamID,...
+		bool persistent_cache = false;
+		std::string persistent_cache_path;
+		std::ofstream persistent_cache_file;
+		std::mutex mutex_persistent_cache;
+
+		void loadPersistentCache();
+		void appendPersistentCache(const std::string &lines);
+
+		// Steam Requests
+		//   Fetched concurrently by SteamGet Threads (one Keep-Alive Connection each)
+		//   A Query's Result is saved as soon as the last Request for its SteamIDs lands, not when all Requests are done
+		struct PendingQuery
+		{
+			SteamQuery query;
+			int remaining_steamIDs = 0;
+		};
+		std::vector<PendingQuery> pending_queries;
+		std::unordered_map<std::string, std::vector<std::size_t> > pending_friends; // SteamID -> pending_queries index
+		std::unordered_map<std::string, std::vector<std::size_t> > pending_bans;
+		std::vector<SteamRequest> requests;
+		std::size_t requests_pos = 0;
+		std::mutex mutex_requests;
 
-		void updateSteamBans(std::vector<std::string> &steamIDs);
-		void updateSteamFriends(std::vector<std::string> &steamIDs);
-		std::string convertSteamIDtoBEGUID(const std::string &input_str);
-		std::vector<std::string> generateSteamIDStrings(std::vector<std::string> &steamIDs);
+		std::vector<std::unique_ptr<SteamGet> > steam_gets;
+		std::vector<std::unique_ptr<Poco::Thread> > steam_get_threads;
 
-		Poco::MD5Engine md5;
-		std::mutex mutex_md5;
+		// Rate Limit, Requests are spaced request_interval apart across all Connections
+		std::chrono::milliseconds request_interval;
+		std::chrono::steady_clock::time_point next_request_time;
+		std::mutex mutex_rate_limit;
 
-		std::atomic<bool> *steam_run_flag;
+		std::atomic<bool> load_bans;
 
-		SteamGet steam_get;
+		void queueRequests(std::vector<SteamQuery> &queries);
+		void saveQueryResult(const SteamQuery &query);
+
+		std::string convertSteamIDtoBEGUID(const std::string &input_str);
+
+		std::atomic<bool> *steam_run_flag;
 
 		std::string log_filename;
 };
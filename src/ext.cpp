@@ -16,6 +16,8 @@ along with this program. If not, see <http://www.gnu.org/licenses/>.
 */
 #include "ext.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
@@ -31,6 +33,8 @@ along with this program. If not, see <http://www.gnu.org/licenses/>.
 #include <boost/filesystem.hpp>
 #ifdef TEST_APP
 	#include <boost/program_options.hpp>
+	#include <Poco/DigestEngine.h>
+	#include <Poco/MD5Engine.h>
 #endif
 #ifdef _WIN32
 	#include <boost/random/random_device.hpp>
@@ -47,8 +51,11 @@ along with this program. If not, see <http://www.gnu.org/licenses/>.
 #include <Poco/StringTokenizer.h>
 #include <Poco/Util/IniFileConfiguration.h>
 
+#include <Poco/Data/DataException.h>
+#include <Poco/Data/RecordSet.h>
 #include <Poco/Data/Session.h>
 #include <Poco/Data/SessionPool.h>
+#include <Poco/Data/Statement.h>
 #include <Poco/Data/MySQL/Connector.h>
 #include <Poco/Data/MySQL/MySQLException.h>
 #include <Poco/Data/SQLite/Connector.h>
@@ -66,6 +73,10 @@ along with this program. If not, see <http://www.gnu.org/licenses/>.
 #include "protocols/rcon.h"
 #include "protocols/steam_v2.h"
 
+#include "hash.h"
+#include "sanitize.h"
+#include "tokenizer.h"
+
 
 
 Ext::Ext(std::string shared_library_path, std::unordered_map<std::string, std::string> &options)
@@ -73,6 +84,7 @@ Ext::Ext(std::string shared_library_path, std::unordered_map<std::string, std::s
 	try
 	{
 		timestamp.update();
+		unique_id_counter = 100;
 		bool conf_found = false;
 		#ifdef _WIN32
 			bool conf_randomized = false;
@@ -232,6 +244,8 @@ Ext::Ext(std::string shared_library_path, std::unordered_map<std::string, std::s
 			console->info("This is used for poor man stress testing");
 			console->info();
 			console->info("Type 'test' for spam test");
+			console->info("Type 'test multipart' for Multi-Part Result benchmark");
+			console->info("Type 'test queries <protocol>:<call>' for Async Queries/sec benchmark i.e test queries SQL:getPlayer:1");
 			console->info("Type 'quit' to exit");
 		#else
 			logger->info("Message: All development for extDB2 is done on a Linux Dedicated Server");
@@ -268,6 +282,8 @@ Ext::Ext(std::string shared_library_path, std::unordered_map<std::string, std::s
 
 			// Start Threads + ASIO
 			ext_info.max_threads = pConf->getInt("Main.Threads", 0);
+			// Workers block for the whole Database round trip, Thread Limit == Max Queries in flight
+			const int thread_limit = std::max(1, pConf->getInt("Main.Thread Limit", 8));
 			int detected_cpu_cores = boost::thread::hardware_concurrency();
 			if (ext_info.max_threads <= 0)
 			{
@@ -297,14 +313,14 @@ Ext::Ext(std::string shared_library_path, std::unordered_map<std::string, std::s
 					logger->info("extDB2: Detected {0} Cores, Setting up {1} Worker Threads", detected_cpu_cores, ext_info.max_threads);
 				}
 			}
-			else if (ext_info.max_threads > 8)  // Sanity Check
+			else if (ext_info.max_threads > thread_limit)  // Sanity Check
 			{
 				// Manual Config
 				#ifdef DEBUG_TESTING
-					console->info("extDB2: Sanity Check, Setting up {0} Worker Threads (config settings {1})", 8, ext_info.max_threads);
+					console->info("extDB2: Sanity Check, Setting up {0} Worker Threads (config settings {1})", thread_limit, ext_info.max_threads);
 				#endif
-				logger->info("extDB2: Sanity Check, Setting up {0} Worker Threads (config settings {1})", 8, ext_info.max_threads);
-				ext_info.max_threads = 8;
+				logger->info("extDB2: Sanity Check, Setting up {0} Worker Threads (config settings {1})", thread_limit, ext_info.max_threads);
+				ext_info.max_threads = thread_limit;
 			}
 			else
 			{
@@ -315,12 +331,38 @@ Ext::Ext(std::string shared_library_path, std::unordered_map<std::string, std::s
 				logger->info("extDB2: Detected {0} Cores, Setting up {1} Worker Threads (config settings)", detected_cpu_cores, ext_info.max_threads);
 			}
 
+			// Bulk Worker Lane, Default == Half of Main Worker Threads (min value is 1, max value is Main Worker Threads)
+			ext_info.bulk_threads = pConf->getInt("Main.Bulk Threads", 0);
+			if (ext_info.bulk_threads <= 0)
+			{
+				ext_info.bulk_threads = std::max(1, (ext_info.max_threads / 2));
+			}
+			else if (ext_info.bulk_threads > ext_info.max_threads)  // Sanity Check
+			{
+				ext_info.bulk_threads = ext_info.max_threads;
+			}
+			#ifdef DEBUG_TESTING
+				console->info("extDB2: Setting up {0} Bulk Worker Threads", ext_info.bulk_threads);
+			#endif
+			logger->info("extDB2: Setting up {0} Bulk Worker Threads", ext_info.bulk_threads);
+
 			// Setup ASIO Worker Pool
 			io_work_ptr.reset(new boost::asio::io_service::work(io_service));
 			for (int i = 0; i < ext_info.max_threads; ++i)
 			{
 				threads.create_thread(boost::bind(&boost::asio::io_service::run, &io_service));
 			}
+			bulk_io_work_ptr.reset(new boost::asio::io_service::work(bulk_io_service));
+			for (int i = 0; i < ext_info.bulk_threads; ++i)
+			{
+				bulk_threads.create_thread(boost::bind(&boost::asio::io_service::run, &bulk_io_service));
+			}
+
+			// Multi-Part Results reply [5,<Chunks>] instead of [5]
+			ext_info.multipart_chunks_hint = pConf->getBool("Main.Multi-Part Chunks Hint", false);
+
+			// Unique Random Strings, 0 == never recycled
+			unique_random_strings_max = std::max(0, pConf->getInt("Main.Unique Strings Max", 0));
 
 			// Initialize so have atomic setup correctly + Setup VAC Ban Logger
 			steam.init(this, ext_info.path, current_dateTime);
@@ -371,16 +413,42 @@ void Ext::stop()
 	if (ext_connectors_info.rcon)
 	{
 		rcon->disconnect();
+
+		std::lock_guard<std::mutex> lock(player_unique_keys_mutex);
+		player_keys_timer_active = false;
+		player_keys_timer->cancel();
+	}
+	for (auto &database : ext_connectors_info.databases)
+	{
+		stopDBSessionPoolMaintenance(database.second);
+		for (auto &read_replica : database.second.read_replicas)
+		{
+			stopDBSessionPoolMaintenance(*read_replica);
+		}
 	}
 	io_work_ptr.reset();
+	bulk_io_work_ptr.reset();
 	rcon_io_work_ptr.reset();
 	threads.join_all();
+	bulk_threads.join_all();
 	rcon_threads.join_all();
 	io_service.stop();
+	bulk_io_service.stop();
 	rcon_io_service.stop();
 
+	if (ext_connectors_info.belog_scanner)
+	{
+		belog_scanner.release();
+	}
+
 	for (auto &database : ext_connectors_info.databases)
 	{
+		// ext_connectors_info is destroyed after bulk_io_service, Pool Timers are released here
+		database.second.pool_timer.reset();
+		for (auto &read_replica : database.second.read_replicas)
+		{
+			read_replica->pool_timer.reset();
+		}
 		//database.second.sql_pool->shutdown();
 	}
 	if (ext_connectors_info.mysql)
@@ -416,151 +484,483 @@ void Ext::stop()
 #endif
 
 
+AbstractExt::DBConnectionInfo &Ext::getReadDBConnection(AbstractExt::DBConnectionInfo &database)
+// Read Only Calls, Round Robin over Read Replicas within Max Replica Lag, else Primary
+{
+	const std::size_t num_of_read_replicas = database.read_replicas.size();
+	if (num_of_read_replicas > 0)
+	{
+		const unsigned int start = database.read_replica_counter++;
+		for (std::size_t i = 0; i < num_of_read_replicas; ++i)
+		{
+			AbstractExt::DBConnectionInfo &read_replica = *database.read_replicas[(start + i) % num_of_read_replicas];
+			if (read_replica.replica_healthy)
+			{
+				return read_replica;
+			}
+		}
+		++database.read_replica_fallbacks;
+	}
+	return database;
+}
+
+
 Poco::Data::Session Ext::getDBSession_mutexlock(AbstractExt::DBConnectionInfo &database)
-// Gets available DB Session (mutex lock)
+// Gets DB Session, Session Pool has its own mutex
 {
-	std::lock_guard<std::mutex> lock(database.mutex_sql_pool);
-	return database.sql_pool->get();
+	Poco::Data::SessionPool::SessionDataPtr session_data_ptr;
+	return getDBSession_mutexlock(database, session_data_ptr);
 }
 
 
 Poco::Data::Session Ext::getDBSession_mutexlock(AbstractExt::DBConnectionInfo &database, Poco::Data::SessionPool::SessionDataPtr &session_data_ptr)
-// Gets available DB Session (mutex lock) + Cached Statemetns
+// Gets DB Session + Cached Statements
+//   Sticky Sessions: Thread reuses its own Session, only checks out from Session Pool on first call / lost connection
 {
-	std::lock_guard<std::mutex> lock(database.mutex_sql_pool);
-	return database.sql_pool->get(session_data_ptr);
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	try
+	{
+		if (database.sticky_sessions)
+		{
+			AbstractExt::DBConnectionInfo::stickySession *sticky_session_ptr = database.sticky_session.get();
+			if ((sticky_session_ptr != nullptr) && ((start - sticky_session_ptr->last_used) > std::chrono::seconds(database.pool_check_interval)))
+			{
+				// Idle longer than Pool Check Interval, Server may have dropped the Connection (MySQL isConnected is only a flag)
+				//   Sticky Sessions are never Idle in the Session Pool, so Pool Maintenance can't ping them
+				//   Pinged here instead, a dead Session is closed + returned to Session Pool (Pool discards it)
+				if (database.type == "MySQL")
+				{
+					try
+					{
+						Poco::Data::Statement sql_statement(sticky_session_ptr->session);
+						sql_statement << "SELECT 1";
+						sql_statement.execute();
+					}
+					catch (Poco::Exception&)
+					{
+						try
+						{
+							sticky_session_ptr->session.close();
+						}
+						catch (Poco::Exception&)
+						{
+						}
+						database.sticky_session.reset();
+						sticky_session_ptr = nullptr;
+					}
+				}
+			}
+			if ((sticky_session_ptr == nullptr) || !(sticky_session_ptr->session.isConnected()))
+			{
+				database.sticky_session.reset(); // Lost Connection, return to Session Pool first
+				Poco::Data::SessionPool::SessionDataPtr new_session_data_ptr;
+				Poco::Data::Session session(database.sql_pool->get(new_session_data_ptr));
+				sticky_session_ptr = new AbstractExt::DBConnectionInfo::stickySession(session, new_session_data_ptr);
+				database.sticky_session.reset(sticky_session_ptr);
+			}
+			sticky_session_ptr->last_used = start;
+			session_data_ptr = sticky_session_ptr->session_data_ptr;
+			addDBSessionWait(database, start);
+			return sticky_session_ptr->session;
+		}
+		else
+		{
+			Poco::Data::Session session(database.sql_pool->get(session_data_ptr));
+			addDBSessionWait(database, start);
+			return session;
+		}
+	}
+	catch (Poco::Data::SessionPoolExhaustedException&)
+	{
+		++database.sessions_exhausted;
+		throw;
+	}
 }
 
 
-void Ext::createPlayerKey_mutexlock(std::string &player_beguid, int len_of_key)
+void Ext::addDBSessionWait(AbstractExt::DBConnectionInfo &database, const std::chrono::steady_clock::time_point &start)
+// Wait Time Histogram, includes waiting on Pool Mutex + connecting new Sessions
 {
-	std::string player_unique_key;
-	int num_of_retrys = 0;
-	int i = 0;
+	static const long long wait_buckets_ms[] = {1, 5, 10, 50, 100, 500};
+	const long long wait_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+	std::size_t bucket = 0;
+	while ((bucket < 6) && (wait_ms >= wait_buckets_ms[bucket]))
 	{
-		std::lock_guard<std::mutex> lock(mutex_RandomString);
-		boost::random::uniform_int_distribution<> index_dist(0, random_chars.size() - 1);
+		++bucket;
+	}
+	++database.wait_histogram[bucket];
+}
+
+
+void Ext::maintainDBSessionPool(AbstractExt::DBConnectionInfo *database_ptr, const boost::system::error_code &error)
+// Session Pool Maintenance, runs on Bulk Worker Lane
+//   Adapts Spare Sessions to Wait Times since last check, pings Idle Sessions + connects Spare Sessions ahead of demand
+{
+	if (error == boost::asio::error::operation_aborted)
+	{
+		return;
+	}
+	DBConnectionInfo &database = *database_ptr;
 
-		while (true)
+	// Waits >= 10ms are Sessions being connected on the call path
+	unsigned int slow_waits = 0;
+	for (std::size_t i = 2; i < database.wait_histogram.size(); ++i)
+	{
+		const unsigned int wait_count = database.wait_histogram[i].load();
+		slow_waits += (wait_count - database.wait_histogram_checked[i]);
+		database.wait_histogram_checked[i] = wait_count;
+	}
+
+	std::size_t connect_sessions = 0;
+	std::size_t ping_sessions = 0;
+	{
+		std::lock_guard<std::mutex> lock(database.mutex_pool_maintenance);
+		const int capacity = database.sql_pool->capacity();
+		if (slow_waits > 0)
+		{
+			database.spare_sessions = std::min(capacity, (database.spare_sessions + 1));
+		}
+		else if (database.spare_sessions > database.min_spare_sessions)
+		{
+			--database.spare_sessions;
+		}
+		ping_sessions = database.sql_pool->idle();
+		const int spare_sessions_needed = database.spare_sessions - database.sql_pool->idle();
+		const int sessions_available = capacity - database.sql_pool->allocated();
+		if ((spare_sessions_needed > 0) && (sessions_available > 0))
 		{
-			std::stringstream random_stream;
-			for (int x = 0; x < len_of_key; ++x)
+			connect_sessions = std::min(spare_sessions_needed, sessions_available);
+		}
+	}
+
+	try
+	{
+		if (database.type == "MySQL")
+		{
+			// MySQL auto-reconnect happens here, instead of on a call
+			//   Pool hands back the last returned Session first, so Sessions are held together to ping different ones
+			//   One Idle Session is left in the Pool for calls (unless it is the only one)
+			std::vector<Poco::Data::Session> sessions;
+			const std::size_t num_of_sessions = (ping_sessions > 1) ? (ping_sessions - 1) : ping_sessions;
+			sessions.reserve(num_of_sessions);
+			for (std::size_t i = 0; i < num_of_sessions; ++i)
 			{
-				random_stream << random_chars[index_dist(random_chars_rng)];
+				sessions.push_back(database.sql_pool->get());
 			}
-			player_unique_key = random_stream.str();
-
-			if (std::find(uniqueRandomVarNames.begin(), uniqueRandomVarNames.end(), player_unique_key) != uniqueRandomVarNames.end())
+			for (auto &session : sessions)
 			{
-				if (num_of_retrys >= 10)
-				{
-					num_of_retrys = 0;
-					++len_of_key; // Increase Random String Length if we failed 10 times
-				}
-				else
-				{
-					++num_of_retrys;
-				}
+				Poco::Data::Statement sql_statement(session);
+				sql_statement << "SELECT 1";
+				sql_statement.execute();
 			}
-			else
+		}
+		if (connect_sessions > 0)
+		{
+			// Held together, Pool hands out Idle Sessions first then connects a new Session each time
+			//   Released back to Pool as Idle Sessions
+			std::vector<Poco::Data::Session> sessions;
+			const std::size_t num_of_sessions = database.sql_pool->idle() + connect_sessions;
+			sessions.reserve(num_of_sessions);
+			for (std::size_t i = 0; i < num_of_sessions; ++i)
 			{
-				uniqueRandomVarNames.push_back(player_unique_key);
-				break;
+				sessions.push_back(database.sql_pool->get());
 			}
 		}
+		if (database.read_replica)
+		{
+			checkReplicaLag(database);
+		}
 	}
-	logger->info("Player Unique ID: {0}", player_unique_key);
+	catch (Poco::Data::SessionPoolExhaustedException& e)
 	{
-		std::lock_guard<std::mutex> lock(player_unique_keys_mutex);
-		player_unique_keys[player_beguid].keys.push_back(std::move(player_unique_key));
-
-		// Create Regex Rule
-		player_unique_keys[player_beguid].regex_rule.clear();
-		for (auto &key : player_unique_keys[player_beguid].keys)
+		// Pool busy with calls, not a Replica Health problem
+		#ifdef DEBUG_TESTING
+			console->warn("extDB2: Database Session Pool Maintenance Skipped: {0}", e.displayText());
+		#endif
+		logger->warn("extDB2: Database Session Pool Maintenance Skipped: {0}", e.displayText());
+	}
+	catch (Poco::Exception& e)
+	{
+		if (database.read_replica)
 		{
-			player_unique_keys[player_beguid].regex_rule += key + "|";
+			database.replica_healthy = false;
 		}
-		if (!(player_unique_keys[player_beguid].regex_rule.empty()))
+		#ifdef DEBUG_TESTING
+			console->warn("extDB2: Database Session Pool Maintenance Error: {0}", e.displayText());
+		#endif
+		logger->warn("extDB2: Database Session Pool Maintenance Error: {0}", e.displayText());
+	}
+
+	std::lock_guard<std::mutex> lock(database.mutex_pool_maintenance);
+	if (database.pool_timer_active)
+	{
+		database.pool_timer->expires_from_now(boost::posix_time::seconds(database.pool_check_interval));
+		database.pool_timer->async_wait(boost::bind(&Ext::maintainDBSessionPool, this, database_ptr, boost::asio::placeholders::error));
+	}
+}
+
+
+void Ext::checkReplicaLag(AbstractExt::DBConnectionInfo &database)
+// Read Replica Health, MySQL Seconds_Behind_Master <= Max Replica Lag
+//   NULL == Replication Stopped, No Rows == Not a Slave (Read Only Copy) + SQLite is always healthy
+{
+	int replica_lag = 0;
+	if (database.type == "MySQL")
+	{
+		Poco::Data::Session session(database.sql_pool->get());
+		Poco::Data::Statement sql_statement(session);
+		sql_statement << "SHOW SLAVE STATUS";
+		sql_statement.execute();
+		Poco::Data::RecordSet rs(sql_statement);
+		if (rs.rowCount() > 0)
 		{
-			player_unique_keys[player_beguid].regex_rule.pop_back();
+			Poco::Dynamic::Var seconds_behind_master = rs.value("Seconds_Behind_Master", 0);
+			replica_lag = seconds_behind_master.isEmpty() ? -1 : seconds_behind_master.convert<int>();
 		}
-		player_unique_keys[player_beguid].regex_rule = "(" + player_unique_keys[player_beguid].regex_rule + ")";
+	}
+	database.replica_lag = replica_lag;
+	const bool replica_healthy = ((replica_lag >= 0) && (replica_lag <= database.max_replica_lag));
+	if (database.replica_healthy.exchange(replica_healthy) != replica_healthy)
+	{
+		#ifdef DEBUG_TESTING
+			console->warn("extDB2: Database Read Replica Healthy: {0} Lag: {1}", replica_healthy, replica_lag);
+		#endif
+		logger->warn("extDB2: Database Read Replica Healthy: {0} Lag: {1}", replica_healthy, replica_lag);
 	}
 }
 
 
-void Ext::delPlayerKey_delayed(std::string &player_beguid)
+void Ext::stopDBSessionPoolMaintenance(AbstractExt::DBConnectionInfo &database)
 {
-	std::lock_guard<std::mutex> lock(player_unique_keys_mutex);
+	std::lock_guard<std::mutex> lock(database.mutex_pool_maintenance);
+	database.pool_timer_active = false;
+	if (database.pool_timer)
+	{
+		database.pool_timer->cancel();
+	}
+}
 
-	logger->info("Removed Player Timer for BEGUID: {0}", player_beguid);
 
-	int diff_time = boost::posix_time::time_duration((boost::posix_time::microsec_clock::local_time() + boost::posix_time::seconds(30)) - timer->expires_at()).total_seconds();
-	if (diff_time <= 0)
+void Ext::getDatabaseStats(char *output, const int &output_size, const std::string &database_id)
+// Session Pool Stats + Wait Time Histogram
+{
+	auto const_itr = ext_connectors_info.databases.find(database_id);
+	if ((const_itr == ext_connectors_info.databases.end()) || (!const_itr->second.sql_pool))
 	{
-		del_players_keys.push_back(std::make_pair(30, player_beguid));
-		timer->expires_from_now(boost::posix_time::seconds(30));
-		timer->async_wait(boost::bind(&Ext::delPlayerKey_mutexlock, this));
+		std::strcpy(output, "[0,\"Error Unknown Database\"]");
 	}
 	else
 	{
-		std::size_t wait_time = 30 - diff_time;
-		del_players_keys.push_back(std::make_pair(wait_time, player_beguid));
+		DBConnectionInfo &database = const_itr->second;
+		std::string result;
+		result.reserve(256);
+		{
+			std::lock_guard<std::mutex> lock(database.mutex_pool_maintenance);
+			result += "[1,[[\"CAPACITY\",";
+			Poco::NumberFormatter::append(result, database.sql_pool->capacity());
+			result += "],[\"ALLOCATED\",";
+			Poco::NumberFormatter::append(result, database.sql_pool->allocated());
+			result += "],[\"USED\",";
+			Poco::NumberFormatter::append(result, database.sql_pool->used());
+			result += "],[\"IDLE\",";
+			Poco::NumberFormatter::append(result, database.sql_pool->idle());
+			result += "],[\"DEAD\",";
+			Poco::NumberFormatter::append(result, database.sql_pool->dead());
+			result += "],[\"SPARE\",";
+			Poco::NumberFormatter::append(result, database.spare_sessions);
+		}
+		result += "],[\"EXHAUSTED\",";
+		Poco::NumberFormatter::append(result, database.sessions_exhausted.load());
+		result += "],[\"WAIT MS <1,<5,<10,<50,<100,<500,>=500\",[";
+		for (std::size_t i = 0; i < database.wait_histogram.size(); ++i)
+		{
+			if (i > 0)
+			{
+				result += ",";
+			}
+			Poco::NumberFormatter::append(result, database.wait_histogram[i].load());
+		}
+		result += "]],[\"READ REPLICAS\",[";
+		for (std::size_t i = 0; i < database.read_replicas.size(); ++i)
+		{
+			if (i > 0)
+			{
+				result += ",";
+			}
+			result += "[";
+			result += (database.read_replicas[i]->replica_healthy ? "true" : "false");
+			result += ",";
+			Poco::NumberFormatter::append(result, database.read_replicas[i]->replica_lag.load());
+			result += ",";
+			Poco::NumberFormatter::append(result, database.read_replicas[i]->sql_pool->used());
+			result += "]";
+		}
+		result += "]],[\"READ REPLICA FALLBACKS\",";
+		Poco::NumberFormatter::append(result, database.read_replica_fallbacks.load());
+		result += "]]]";
+
+		if (result.length() <= output_size)
+		{
+			std::strcpy(output, result.c_str());
+		}
+		else
+		{
+			std::strcpy(output, "[0,\"Error Result Larger than Output Size\"]");
+		}
 	}
 }
 
 
-void Ext::delPlayerKey_mutexlock()
+boost::asio::io_service &Ext::getIOService()
+// Main ASIO Thread Queue, used by Protocols for Timers
 {
-	std::lock_guard<std::mutex> lock(player_unique_keys_mutex);
+	return io_service;
+}
+
+
+boost::asio::io_service &Ext::getBulkIOService()
+// Bulk ASIO Thread Queue, used by Protocols for Timers that run bulk work i.e Write Behind Flush
+{
+	return bulk_io_service;
+}
 
-	logger->info("Removed Player Unique ID ");
 
+void Ext::createPlayerKey_mutexlock(std::string &player_beguid, int len_of_key)
+{
+	std::string player_unique_key;
+	int num_of_retrys = 0;
 	while (true)
 	{
-		if (del_players_keys.size() == 0)
+		getRandomString(player_unique_key, len_of_key);
+		if (addUniqueString_mutexlock(player_unique_key, false))
 		{
 			break;
 		}
-		if (del_players_keys.front().first > 1)
+		if (num_of_retrys >= 10)
 		{
-			timer->expires_from_now(boost::posix_time::seconds(del_players_keys.front().first));
-			timer->async_wait(boost::bind(&Ext::delPlayerKey_mutexlock, this));
-			break;
+			num_of_retrys = 0;
+			++len_of_key; // Increase Random String Length if we failed 10 times
 		}
 		else
 		{
-			if (player_unique_keys.count(del_players_keys.front().second))
+			++num_of_retrys;
+		}
+	}
+	logger->info("Player Unique ID: {0}", player_unique_key);
+	{
+		// Copy-on-Write, readers keep using the old map until they load it again
+		std::lock_guard<std::mutex> lock(player_unique_keys_mutex);
+		std::shared_ptr<PlayerKeysMap> new_player_unique_keys = std::make_shared<PlayerKeysMap>(*std::atomic_load(&player_unique_keys));
+		PlayerKeys &player_keys = (*new_player_unique_keys)[player_beguid];
+		player_keys.keys.push_back(std::move(player_unique_key));
+		updatePlayerRegex(player_keys);
+		std::atomic_store(&player_unique_keys, std::shared_ptr<const PlayerKeysMap>(std::move(new_player_unique_keys)));
+	}
+}
+
+
+void Ext::updatePlayerRegex(PlayerKeys &player_keys)
+// Regex Rule (key1|key2|...) used by BELogScanner [:player_key:]
+{
+	player_keys.regex_rule = "(";
+	for (auto &key : player_keys.keys)
+	{
+		player_keys.regex_rule += key + "|";
+	}
+	if (player_keys.regex_rule.size() > 1)
+	{
+		player_keys.regex_rule.pop_back();
+	}
+	player_keys.regex_rule += ")";
+}
+
+
+void Ext::delPlayerKey_delayed(std::string &player_beguid)
+// Removes oldest Player Key for BEGUID in 30 seconds
+{
+	std::lock_guard<std::mutex> lock(player_unique_keys_mutex);
+
+	logger->info("Removed Player Timer for BEGUID: {0}", player_beguid);
+
+	player_keys_wheel[(player_keys_wheel_pos + 30) % player_keys_wheel.size()].push_back(player_beguid);
+	if ((player_keys_wheel_count++ == 0) && player_keys_timer_active)
+	{
+		player_keys_timer->expires_from_now(boost::posix_time::seconds(1));
+		player_keys_timer->async_wait(boost::bind(&Ext::delPlayerKey_mutexlock, this, boost::asio::placeholders::error));
+	}
+}
+
+
+void Ext::delPlayerKey_mutexlock(const boost::system::error_code &error)
+// Timer Wheel Tick (1 second), only ticks while Player Keys are waiting to be removed
+{
+	if (error == boost::asio::error::operation_aborted)
+	{
+		return;
+	}
+
+	std::vector<std::string> player_beguids;
+	std::lock_guard<std::mutex> lock(player_unique_keys_mutex);
+	player_keys_wheel_pos = (player_keys_wheel_pos + 1) % player_keys_wheel.size();
+	player_beguids.swap(player_keys_wheel[player_keys_wheel_pos]);
+	if (!player_beguids.empty())
+	{
+		player_keys_wheel_count -= player_beguids.size();
+
+		std::shared_ptr<PlayerKeysMap> new_player_unique_keys = std::make_shared<PlayerKeysMap>(*std::atomic_load(&player_unique_keys));
+		for (auto &player_beguid : player_beguids)
+		{
+			auto itr = new_player_unique_keys->find(player_beguid);
+			if (itr != new_player_unique_keys->end())
 			{
-				player_unique_keys[del_players_keys.front().second].keys.pop_front();
-				if (player_unique_keys[del_players_keys.front().second].keys.empty())
 				{
-					player_unique_keys.erase(del_players_keys.front().second);
+					// Player Key no longer used, free it from the Unique Strings (Player Keys aren't in the recycle FIFO)
+					std::lock_guard<std::mutex> lock_random_string(mutex_RandomString);
+					unique_random_strings.erase(itr->second.keys.front());
+				}
+				itr->second.keys.erase(itr->second.keys.begin());
+				if (itr->second.keys.empty())
+				{
+					new_player_unique_keys->erase(itr);
 				}
-				logger->info("Removed Player Unique ID for BEGUID 2: {0}", del_players_keys.front().second);
+				else
+				{
+					updatePlayerRegex(itr->second);
+				}
+				logger->info("Removed Player Unique ID for BEGUID: {0}", player_beguid);
 			}
-			del_players_keys.pop_front();
 		}
+		std::atomic_store(&player_unique_keys, std::shared_ptr<const PlayerKeysMap>(std::move(new_player_unique_keys)));
+	}
+
+	if ((player_keys_wheel_count > 0) && player_keys_timer_active)
+	{
+		player_keys_timer->expires_from_now(boost::posix_time::seconds(1));
+		player_keys_timer->async_wait(boost::bind(&Ext::delPlayerKey_mutexlock, this, boost::asio::placeholders::error));
 	}
 }
 
 
 void Ext::getPlayerKey_BEGuid(std::string &player_beguid, std::string &player_key)
+// Lock-Free, reads current Player Keys Snapshot
 {
-	std::lock_guard<std::mutex> lock(player_unique_keys_mutex);
-	if (player_unique_keys.count(player_beguid))
+	std::shared_ptr<const PlayerKeysMap> player_keys_snapshot = std::atomic_load(&player_unique_keys);
+	auto const_itr = player_keys_snapshot->find(player_beguid);
+	if (const_itr != player_keys_snapshot->end())
 	{
-		player_key = player_unique_keys[player_beguid].keys.back();
+		player_key = const_itr->second.keys.back();
 	}
 }
 
 
 std::string Ext::getPlayerRegex_BEGuid(std::string &player_beguid)
+// Lock-Free, reads current Player Keys Snapshot
 {
-	std::lock_guard<std::mutex> lock(player_unique_keys_mutex);
-	if (player_unique_keys.count(player_beguid))
+	std::shared_ptr<const PlayerKeysMap> player_keys_snapshot = std::atomic_load(&player_unique_keys);
+	auto const_itr = player_keys_snapshot->find(player_beguid);
+	if (const_itr != player_keys_snapshot->end())
 	{
-		return player_unique_keys[player_beguid].regex_rule;
+		return const_itr->second.regex_rule;
 	}
 	else
 	{
@@ -571,33 +971,10 @@ std::string Ext::getPlayerRegex_BEGuid(std::string &player_beguid)
 
 void Ext::getPlayerKey_SteamID(std::string &player_steam_id, std::string &player_key)
 {
-	Poco::Int64 steamID = Poco::NumberParser::parse64(player_steam_id);
-	Poco::Int8 i = 0;
-	Poco::Int8 parts[8] = { 0 };
-
-	do
-	{
-		parts[i++] = steamID & 0xFFu;
-	} while (steamID >>= 8);
-
-	std::stringstream bestring;
-	bestring << "BE";
-	for (auto &part: parts)
-	{
-		bestring << char(part);
-	}
-
 	std::string player_beguid;
+	if (Hash::getBEGUID(player_steam_id, player_beguid))
 	{
-		std::lock_guard<std::mutex> lock(mutex_md5);
-		md5.update(bestring.str());
-		player_beguid = Poco::DigestEngine::digestToHex(md5.digest());
-	}
-
-	std::lock_guard<std::mutex> lock(player_unique_keys_mutex);
-	if (player_unique_keys.count(player_beguid))
-	{
-		player_key = player_unique_keys[player_beguid].keys.back();
+		getPlayerKey_BEGuid(player_beguid, player_key);
 	}
 }
 
@@ -632,7 +1009,7 @@ void Ext::startBELogscanner(char *output, const std::string &conf)
 	{
 		if (!ext_connectors_info.belog_scanner)
 		{
-			belog_scanner.start(this, io_service);
+			belog_scanner.start(this, bulk_io_service);
 			ext_connectors_info.belog_scanner = true;
 			std::strcpy(output, ("[1]"));
 		}
@@ -754,7 +1131,11 @@ void Ext::startRcon(char *output, const std::string &conf, std::vector<std::stri
 		}
 
 		// Start Rcon
-		timer.reset(new boost::asio::deadline_timer(io_service));
+		{
+			std::lock_guard<std::mutex> lock(player_unique_keys_mutex);
+			player_keys_timer.reset(new boost::asio::deadline_timer(io_service));
+			player_keys_timer_active = true;
+		}
 		rcon->start(rcon_settings, bad_playername_settings, whitelist_settings, pConf);
 		ext_connectors_info.rcon = true;
 		std::strcpy(output, "[1]");
@@ -794,7 +1175,7 @@ void Ext::rconPlayers(unsigned int unique_id)
 }
 
 
-void Ext::getUPTime(std::string &token, std::string &result)
+void Ext::getUPTime(const std::string &token, std::string &result)
 {
 	if (token == "SECONDS")
 	{
@@ -830,7 +1211,7 @@ void Ext::getLocalDateTime(std::string &result)
 }
 
 
-void Ext::getDateAdd(std::string& time1, std::string& input_str, std::string &result)
+void Ext::getDateAdd(const std::string &time1, std::string input_str, std::string &result)
 {
 	input_str.erase(input_str.begin());
 	input_str.pop_back();
@@ -868,7 +1249,7 @@ void Ext::getDateAdd(std::string& time1, std::string& input_str, std::string &re
 }
 
 
-void Ext::getCurrentTimeDiff(std::string &type, std::string& time1, std::string &result)
+void Ext::getCurrentTimeDiff(const std::string &type, const std::string &time1, std::string &result)
 {
 	Poco::DateTimeParser::parse(timeDiff_fmt, time1, dateDiffTime_1, timeDiff_zoneDiff);
 	timespan = dateDiffTime_1 - Poco::DateTime();
@@ -886,7 +1267,7 @@ void Ext::getCurrentTimeDiff(std::string &type, std::string& time1, std::string
 	};
 }
 
-void Ext::getCurrentLocalTimeDiff(std::string &type, std::string& time1, std::string &result)
+void Ext::getCurrentLocalTimeDiff(const std::string &type, const std::string &time1, std::string &result)
 {
 	Poco::DateTimeParser::parse(timeDiff_fmt, time1, dateDiffTime_1, timeDiff_zoneDiff);
 	timespan = dateDiffTime_1 - Poco::LocalDateTime().utc();
@@ -905,7 +1286,7 @@ void Ext::getCurrentLocalTimeDiff(std::string &type, std::string& time1, std::st
 }
 
 
-void Ext::getCurrentTimeDiff(std::string &type, std::string &time1, std::string &offset, std::string &result)
+void Ext::getCurrentTimeDiff(const std::string &type, const std::string &time1, const std::string &offset, std::string &result)
 {
 	if (!(offset.empty()))
 	{
@@ -934,7 +1315,7 @@ void Ext::getCurrentTimeDiff(std::string &type, std::string &time1, std::string
 }
 
 
-void Ext::getTimeDiff(std::string &type, std::string& time1, std::string& time2, std::string &result)
+void Ext::getTimeDiff(const std::string &type, const std::string &time1, const std::string &time2, std::string &result)
 {
 	Poco::DateTimeParser::parse(timeDiff_fmt, time1, dateDiffTime_1, timeDiff_zoneDiff);
 	Poco::DateTimeParser::parse(timeDiff_fmt, time2, dateDiffTime_2, timeDiff_zoneDiff);
@@ -954,26 +1335,59 @@ void Ext::getTimeDiff(std::string &type, std::string& time1, std::string& time2,
 }
 
 
+void Ext::getRandomString(std::string &random_string, const int &len_of_string)
+{
+	boost::random::mt19937 *rng = random_string_rng.get();
+	if (rng == nullptr)
+	{
+		// First call on this Thread, random_device isn't thread safe
+		std::lock_guard<std::mutex> lock(mutex_RandomString);
+		rng = new boost::random::mt19937(random_chars_rng());
+		random_string_rng.reset(rng);
+	}
+	boost::random::uniform_int_distribution<> index_dist(0, random_chars.size() - 1);
+
+	random_string.resize(len_of_string);
+	for (auto &random_char : random_string)
+	{
+		random_char = random_chars[index_dist(*rng)];
+	}
+}
+
+
+bool Ext::addUniqueString_mutexlock(const std::string &random_string, const bool recycle)
+// Returns false if random_string was already used
+//   recycle == false, never evicted by Unique Strings Max (Player Keys stay unique while the Player is connected)
+{
+	std::lock_guard<std::mutex> lock(mutex_RandomString);
+	if (!(unique_random_strings.insert(random_string).second))
+	{
+		return false;
+	}
+	if (recycle && (unique_random_strings_max > 0))
+	{
+		unique_random_strings_order.push_back(random_string);
+		if (unique_random_strings_order.size() > unique_random_strings_max)
+		{
+			unique_random_strings.erase(unique_random_strings_order.front());
+			unique_random_strings_order.pop_front();
+		}
+	}
+	return true;
+}
+
+
 void Ext::getUniqueString(int &len_of_string, int &num_of_strings, std::string &result)
 {
 	int num_of_retrys = 0;
 	std::string random_string;
 
-	std::lock_guard<std::mutex> lock(mutex_RandomString);
-	boost::random::uniform_int_distribution<> index_dist(0, random_chars.size() - 1);
-
-	result = "[";
+	result = "[1,[";
 	int i = 0;
 	while (i < num_of_strings)
 	{
-		std::stringstream random_stream;
-		for(int x = 0; x < len_of_string; ++x)
-		{
-			random_stream << random_chars[index_dist(random_chars_rng)];
-		}
-		random_string = random_stream.str();
-
-		if (std::find(uniqueRandomVarNames.begin(), uniqueRandomVarNames.end(), random_string) != uniqueRandomVarNames.end())
+		getRandomString(random_string, len_of_string);
+		if (!(addUniqueString_mutexlock(random_string, true)))
 		{
 			if (num_of_retrys >= 10)
 			{
@@ -987,19 +1401,111 @@ void Ext::getUniqueString(int &len_of_string, int &num_of_strings, std::string &
 		}
 		else
 		{
-			if (i == 0)
+			if (i != 0)
 			{
-				result =+ "\"" + random_string + "\"";
+				result += ",";
 			}
-			else
+			result += "\"";
+			result += random_string;
+			result += "\"";
+			++i;
+		}
+	}
+	result += "]]";
+}
+
+
+bool Ext::startDBSessionPool(AbstractExt::DBConnectionInfo &database, const std::string &database_conf)
+// Starts Session Pool for Database / Read Replica, database.type already set
+//   Returns false if not connected, throws Poco::Exception on connection errors
+{
+	std::string connection_str;
+	if (boost::algorithm::iequals(database.type, std::string("MySQL")) == 1)
+	{
+		database.type = "MySQL";
+		if (!(ext_connectors_info.mysql))
+		{
+			Poco::Data::MySQL::Connector::registerConnector();
+			ext_connectors_info.mysql = true;
+		}
+		connection_str += "host=" + pConf->getString(database_conf + ".IP") + ";";
+		connection_str += "port=" + pConf->getString(database_conf + ".Port") + ";";
+		connection_str += "user=" + pConf->getString(database_conf + ".Username") + ";";
+		connection_str += "password=" + pConf->getString(database_conf + ".Password") + ";";
+		connection_str += "db=" + pConf->getString(database_conf + ".Name") + ";";
+		connection_str += "auto-reconnect=true";
+
+		if (pConf->getBool(database_conf + ".Compress", false))
+		{
+			connection_str += ";compress=true";
+		}
+		if (pConf->getBool(database_conf + ".Secure Auth", false))
+		{
+			connection_str += ";secure-auth=true";
+		}
+	}
+	else if (boost::algorithm::iequals(database.type, "SQLite") == 1)
+	{
+		database.type = "SQLite";
+		if (!(ext_connectors_info.sqlite))
+		{
+			Poco::Data::SQLite::Connector::registerConnector();
+			ext_connectors_info.sqlite = true;
+		}
+
+		boost::filesystem::path sqlite_path(ext_info.path);
+		sqlite_path /= "extDB";
+		sqlite_path /= "sqlite";
+		sqlite_path /= pConf->getString(database_conf + ".Name");
+		connection_str = sqlite_path.make_preferred().string();
+	}
+	else
+	{
+		return false;
+	}
+	database.sql_pool.reset(new Poco::Data::SessionPool(database.type,
+														connection_str,
+														pConf->getInt(database_conf + ".minSessions", 1),
+														pConf->getInt(database_conf + ".maxSessions", (ext_info.max_threads + ext_info.bulk_threads + 2)), // + Arma Thread + Pool Maintenance
+														pConf->getInt(database_conf + ".idleTime", 600)));
+	if (database.sql_pool->get().isConnected())
+	{
+		#ifdef DEBUG_TESTING
+			console->info("extDB2: Database Session Pool Started: {0}", database_conf);
+		#endif
+		logger->info("extDB2: Database Session Pool Started: {0}", database_conf);
+
+		// Pre-Warm Sessions, so first calls after Server Restart don't wait on connection setup
+		const int pre_warm_sessions = std::min(database.sql_pool->capacity(), pConf->getInt(database_conf + ".Pre-Warm Sessions", ext_info.max_threads));
+		{
+			std::vector<Poco::Data::Session> sessions;
+			for (int i = 0; i < pre_warm_sessions; ++i)
 			{
-				result =+ ",\"" + random_string + "\"";
+				sessions.push_back(database.sql_pool->get());
 			}
-			uniqueRandomVarNames.push_back(random_string);
-			++i;
 		}
+		#ifdef DEBUG_TESTING
+			console->info("extDB2: Database Session Pool Pre-Warmed {0} Sessions", pre_warm_sessions);
+		#endif
+		logger->info("extDB2: Database Session Pool Pre-Warmed {0} Sessions", pre_warm_sessions);
+
+		database.sticky_sessions = pConf->getBool(database_conf + ".Sticky Sessions", true);
+
+		// Session Pool Maintenance, 0 == Disabled
+		database.pool_check_interval = pConf->getInt(database_conf + ".Pool Check Interval", 30);
+		database.min_spare_sessions = std::max(0, pConf->getInt(database_conf + ".Min Spare Sessions", 1));
+		database.spare_sessions = database.min_spare_sessions;
+		if (database.pool_check_interval > 0)
+		{
+			std::lock_guard<std::mutex> lock(database.mutex_pool_maintenance);
+			database.pool_timer_active = true;
+			database.pool_timer.reset(new boost::asio::deadline_timer(bulk_io_service));
+			database.pool_timer->expires_from_now(boost::posix_time::seconds(database.pool_check_interval));
+			database.pool_timer->async_wait(boost::bind(&Ext::maintainDBSessionPool, this, &database, boost::asio::placeholders::error));
+		}
+		return true;
 	}
-	result =+ "]";
+	return false;
 }
 
 
@@ -1034,58 +1540,43 @@ void Ext::connectDatabase(char *output, const std::string &database_conf, const
 			{
 				try
 				{
-					// Database
-					std::string connection_str;
-					if (boost::algorithm::iequals(database->type, std::string("MySQL")) == 1)
+					if (startDBSessionPool(*database, database_conf))
 					{
-						database->type = "MySQL";
-						if (!(ext_connectors_info.mysql))
-						{
-							Poco::Data::MySQL::Connector::registerConnector();
-							ext_connectors_info.mysql = true;
-						}
-						connection_str += "host=" + pConf->getString(database_conf + ".IP") + ";";
-						connection_str += "port=" + pConf->getString(database_conf + ".Port") + ";";
-						connection_str += "user=" + pConf->getString(database_conf + ".Username") + ";";
-						connection_str += "password=" + pConf->getString(database_conf + ".Password") + ";";
-						connection_str += "db=" + pConf->getString(database_conf + ".Name") + ";";
-						connection_str += "auto-reconnect=true";
-
-						if (pConf->getBool(database_conf + ".Compress", false))
+						// Read Replicas, failed Replicas are skipped (Read Only Calls use Primary)
+						database->max_replica_lag = pConf->getInt(database_conf + ".Max Replica Lag", 5);
+						Poco::StringTokenizer tokens_read_replicas(pConf->getString(database_conf + ".Read Replicas", ""), ",", Poco::StringTokenizer::TOK_TRIM | Poco::StringTokenizer::TOK_IGNORE_EMPTY);
+						for (auto &read_replica_conf : tokens_read_replicas)
 						{
-							connection_str += ";compress=true";
-						}
-						if (pConf->getBool(database_conf + ".Secure Auth", false))
-						{
-							connection_str += ";secure-auth=true";
-						}
-					}
-					else if (boost::algorithm::iequals(database->type, "SQLite") == 1)
-					{
-						database->type = "SQLite";
-						if (!(ext_connectors_info.sqlite))
-						{
-							Poco::Data::SQLite::Connector::registerConnector();
-							ext_connectors_info.sqlite = true;
+							std::unique_ptr<DBConnectionInfo> read_replica(new DBConnectionInfo());
+							read_replica->type = pConf->getString(read_replica_conf + ".Type", database->type);
+							read_replica->read_replica = true;
+							read_replica->max_replica_lag = database->max_replica_lag;
+							try
+							{
+								if (startDBSessionPool(*read_replica, read_replica_conf))
+								{
+									#ifdef DEBUG_TESTING
+										console->info("extDB2: Database Read Replica Started: {0}", read_replica_conf);
+									#endif
+									logger->info("extDB2: Database Read Replica Started: {0}", read_replica_conf);
+									database->read_replicas.push_back(std::move(read_replica));
+								}
+								else
+								{
+									#ifdef DEBUG_TESTING
+										console->warn("extDB2: Database Read Replica Failed: {0}", read_replica_conf);
+									#endif
+									logger->warn("extDB2: Database Read Replica Failed: {0}", read_replica_conf);
+								}
+							}
+							catch (Poco::Exception& e)
+							{
+								#ifdef DEBUG_TESTING
+									console->warn("extDB2: Database Read Replica Failed: {0} Error: {1}", read_replica_conf, e.displayText());
+								#endif
+								logger->warn("extDB2: Database Read Replica Failed: {0} Error: {1}", read_replica_conf, e.displayText());
+							}
 						}
-
-						boost::filesystem::path sqlite_path(ext_info.path);
-						sqlite_path /= "extDB";
-						sqlite_path /= "sqlite";
-						sqlite_path /= pConf->getString(database_conf + ".Name");
-						connection_str = sqlite_path.make_preferred().string();
-					}
-					database->sql_pool.reset(new Poco::Data::SessionPool(database->type,
-																		connection_str,
-																		pConf->getInt(database_conf + ".minSessions", 1),
-																		pConf->getInt(database_conf + ".maxSessions", ext_info.max_threads),
-																		pConf->getInt(database_conf + ".idleTime", 600)));
-					if (database->sql_pool->get().isConnected())
-					{
-						#ifdef DEBUG_TESTING
-							console->info("extDB2: Database Session Pool Started");
-						#endif
-						logger->info("extDB2: Database Session Pool Started");
 						std::strcpy(output, "[1]");
 					}
 					else
@@ -1218,6 +1709,10 @@ void Ext::addProtocol(char *output, const std::string &database_id, const std::s
 
 		if (status)
 		{
+			// Bulk Protocols, Async Calls run on Bulk Worker Lane
+			Poco::StringTokenizer tokens_bulk_protocols(pConf->getString("Main.Bulk Protocols", ""), ",", Poco::StringTokenizer::TOK_TRIM | Poco::StringTokenizer::TOK_IGNORE_EMPTY);
+			unordered_map_protocol[protocol_name].get()->bulk = tokens_bulk_protocols.has(protocol_name);
+
 			if (unordered_map_protocol[protocol_name].get()->init(this, database_id, init_data))
 			{
 				std::strcpy(output, "[1]");
@@ -1233,15 +1728,22 @@ void Ext::addProtocol(char *output, const std::string &database_id, const std::s
 }
 
 
+Ext::resultShard &Ext::getResultShard(const unsigned int &unique_id)
+{
+	return results_shards[unique_id % results_shards.size()];
+}
+
+
 void Ext::getSinglePartResult_mutexlock(char *output, const int &output_size, const unsigned int &unique_id)
 // Gets Result String from unordered map array -- Result Formt == Single-Message
 //   If <=, then sends output to arma, and removes entry from unordered map array
-//   If >, sends [5] to indicate MultiPartResult
+//   If >, sends [5] to indicate MultiPartResult ([5,<Chunks>] with Main.Multi-Part Chunks Hint)
 {
-	std::lock_guard<std::mutex> lock(mutex_results);
+	resultShard &shard = getResultShard(unique_id);
+	std::lock_guard<std::mutex> lock(shard.mutex_results);
 
-	auto const_itr = stored_results.find(unique_id);
-	if (const_itr == stored_results.end()) // NO UNIQUE ID
+	auto const_itr = shard.stored_results.find(unique_id);
+	if (const_itr == shard.stored_results.end()) // NO UNIQUE ID
 	{
 		std::strcpy(output, "");
 	}
@@ -1253,12 +1755,21 @@ void Ext::getSinglePartResult_mutexlock(char *output, const int &output_size, co
 		}
 		else if (const_itr->second.message.length() > output_size)
 		{
-			std::strcpy(output, "[5]");
+			if (ext_info.multipart_chunks_hint)
+			{
+				// Number of 5: Calls with data, client can fetch them all in one loop
+				const std::string::size_type chunks = ((const_itr->second.message.length() - 1) / output_size) + 1;
+				std::strcpy(output, ("[5," + Poco::NumberFormatter::format(chunks) + "]").c_str());
+			}
+			else
+			{
+				std::strcpy(output, "[5]");
+			}
 		}
 		else
 		{
 			std::strcpy(output, const_itr->second.message.c_str());
-			stored_results.erase(const_itr);
+			shard.stored_results.erase(const_itr);
 		}
 	}
 }
@@ -1268,12 +1779,16 @@ void Ext::getMultiPartResult_mutexlock(char *output, const int &output_size, con
 // Gets Result String from unordered map array  -- Result Format = Multi-Message
 //   If length of String = 0, sends arma "", and removes entry from unordered map array
 //   If <=, then sends output to arma
-//   If >, then sends 1 part to arma + stores rest.
+//   If >, then sends 1 part to arma + advances read cursor (no copy of remaining message)
+//   Entry is removed when the last part is sent, later calls get ""
 {
-	std::lock_guard<std::mutex> lock(mutex_results);
+	std::string finished_message; // Declared before lock, so large message is freed after lock is released
 
-	auto const_itr = stored_results.find(unique_id);
-	if (const_itr == stored_results.end()) // NO UNIQUE ID or WAIT
+	resultShard &shard = getResultShard(unique_id);
+	std::lock_guard<std::mutex> lock(shard.mutex_results);
+
+	auto const_itr = shard.stored_results.find(unique_id);
+	if (const_itr == shard.stored_results.end()) // NO UNIQUE ID or WAIT
 	{
 		std::strcpy(output, "");
 	}
@@ -1281,72 +1796,90 @@ void Ext::getMultiPartResult_mutexlock(char *output, const int &output_size, con
 	{
 		std::strcpy(output, "[3]");
 	}
-	else if (const_itr->second.message.empty()) // END of MSG
+	else if (const_itr->second.message_pos >= const_itr->second.message.length()) // END of MSG
 	{
-		stored_results.erase(const_itr);
+		finished_message.swap(const_itr->second.message);
+		shard.stored_results.erase(const_itr);
 		std::strcpy(output, "");
 	}
 	else // SEND MSG (Part)
 	{
-		if (const_itr->second.message.length() > output_size)
+		const std::string::size_type chunk_size = std::min((const_itr->second.message.length() - const_itr->second.message_pos), static_cast<std::string::size_type>(output_size));
+		std::memcpy(output, (const_itr->second.message.data() + const_itr->second.message_pos), chunk_size);
+		output[chunk_size] = '\0';
+		const_itr->second.message_pos += chunk_size;
+		if (const_itr->second.message_pos >= const_itr->second.message.length())
 		{
-			std::strcpy(output, const_itr->second.message.substr(0, output_size).c_str());
-			const_itr->second.message = const_itr->second.message.substr(output_size);
-		}
-		else
-		{
-			std::strcpy(output, const_itr->second.message.c_str());
-			const_itr->second.message.clear();
+			// Last Part, removed now so clients trusting [5,<Chunks>] don't leak the Result. Next call gets "" (NO UNIQUE ID)
+			finished_message.swap(const_itr->second.message);
+			shard.stored_results.erase(const_itr);
 		}
 	}
 }
 
 
-const unsigned int Ext::saveResult_mutexlock(const resultData &result_data)
+const unsigned int Ext::saveResult_mutexlock(resultData &result_data)
 // Stores Result String and returns Unique ID, used by SYNC Calls where message > outputsize
 {
-	std::lock_guard<std::mutex> lock(mutex_results);
 	const unsigned int unique_id = unique_id_counter++;
-	stored_results[unique_id] = std::move(result_data);
-	stored_results[unique_id].wait = false;
+	result_data.wait = false;
+
+	resultShard &shard = getResultShard(unique_id);
+	std::lock_guard<std::mutex> lock(shard.mutex_results);
+	shard.stored_results[unique_id] = std::move(result_data);
 	return unique_id;
 }
 
 
-void Ext::saveResult_mutexlock(const unsigned int &unique_id, const resultData &result_data)
+void Ext::saveResult_mutexlock(const unsigned int &unique_id, resultData &result_data)
 // Stores Result String for Unique ID
+//   Message is moved into the shard, so the lock is never held while copying a large result
 {
-	std::lock_guard<std::mutex> lock(mutex_results);
-	stored_results[unique_id] = std::move(result_data);
-	stored_results[unique_id].wait = false;
+	result_data.wait = false;
+
+	resultShard &shard = getResultShard(unique_id);
+	std::lock_guard<std::mutex> lock(shard.mutex_results);
+	shard.stored_results[unique_id] = std::move(result_data);
 }
 
 
-void Ext::saveResult_mutexlock(std::vector<unsigned int> &unique_ids, const resultData &result_data)
+void Ext::saveResult_mutexlock(std::vector<unsigned int> &unique_ids, resultData &result_data)
 // Stores Result for multiple Unique IDs (used by Rcon Backend)
 {
-	std::lock_guard<std::mutex> lock(mutex_results);
+	result_data.wait = false;
 	for (auto &unique_id : unique_ids)
 	{
-		stored_results[unique_id] = result_data;
-		stored_results[unique_id].wait = false;
+		resultData result_data_copy = result_data; // Copy outside of lock
+
+		resultShard &shard = getResultShard(unique_id);
+		std::lock_guard<std::mutex> lock(shard.mutex_results);
+		shard.stored_results[unique_id] = std::move(result_data_copy);
 	}
 }
 
 
-void Ext::syncCallProtocol(char *output, const int &output_size, std::string &input_str)
+bool Ext::parseUniqueID(const char *function, unsigned int &unique_id)
+// Parses Unique ID from 4:<ID> / 5:<ID> without copying input
+{
+	char *end_ptr = nullptr;
+	unique_id = std::strtoul(function + 2, &end_ptr, 10);
+	return ((end_ptr != (function + 2)) && (*end_ptr == '\0'));
+}
+
+
+void Ext::syncCallProtocol(char *output, const int &output_size, const boost::string_ref &input_str)
 // Sync callPlugin
 {
-	const std::string::size_type found = input_str.find(":",2);
+	const boost::string_ref::size_type found = input_str.substr(2).find(':');
 
-	if ((found==std::string::npos) || (found == (call_extension_input_str_length - 1)))
+	if ((found==boost::string_ref::npos) || ((found + 2) == (call_extension_input_str_length - 1)))
 	{
 		std::strcpy(output, "[0,\"Error Invalid Format\"]");
-		logger->error("extDB2: Invalid Format: {0}", input_str);
+		logger->error("extDB2: Invalid Format: {0}", input_str.to_string());
 	}
 	else
 	{
-		auto const_itr = unordered_map_protocol.find(input_str.substr(2,(found-2)));
+		auto const_itr = unordered_map_protocol.find(input_str.substr(2, found).to_string());
 		if (const_itr == unordered_map_protocol.end())
 		{
 			std::strcpy(output, "[0,\"Error Unknown Protocol\"]");
@@ -1356,7 +1889,7 @@ void Ext::syncCallProtocol(char *output, const int &output_size, std::string &in
 			resultData result_data;
 			result_data.message.reserve(output_size);
 
-			const_itr->second->callProtocol(input_str.substr(found+1), result_data.message, false);
+			const_itr->second->callProtocol(input_str.substr(found + 3).to_string(), result_data.message, false);
 			if (result_data.message.length() <= output_size)
 			{
 				std::strcpy(output, result_data.message.c_str());
@@ -1371,6 +1904,85 @@ void Ext::syncCallProtocol(char *output, const int &output_size, std::string &in
 }
 
 
+void Ext::getProtocolStats(char *output, const int &output_size, const std::string &protocol_name)
+// Protocol Stats i.e SQL_CUSTOM_V2 Prepared Statement Cache Hits / Misses
+{
+	auto const_itr = unordered_map_protocol.find(protocol_name);
+	if (const_itr == unordered_map_protocol.end())
+	{
+		std::strcpy(output, "[0,\"Error Unknown Protocol\"]");
+	}
+	else
+	{
+		std::string result;
+		const_itr->second->getStats(result);
+		if (result.length() <= output_size)
+		{
+			std::strcpy(output, result.c_str());
+		}
+		else
+		{
+			std::strcpy(output, "[0,\"Error Result Larger than Output Size\"]");
+		}
+	}
+}
+
+
+bool Ext::isBulkCall(const boost::string_ref &input_str)
+// Worker Lane for Async Call, Unknown Protocols use Main Lane (error is logged by worker)
+{
+	const boost::string_ref::size_type found = input_str.substr(2).find(':');
+	if (found == boost::string_ref::npos)
+	{
+		return false;
+	}
+	auto const_itr = unordered_map_protocol.find(input_str.substr(2, found).to_string());
+	if (const_itr == unordered_map_protocol.end())
+	{
+		return false;
+	}
+	return const_itr->second->isBulkCall(input_str.substr(found + 3));
+}
+
+
+void Ext::getWorkerStats(char *output, const int &output_size)
+// Worker Lanes [Threads, Queued, Max Queued, Active, Completed]
+{
+	std::string result;
+	result.reserve(128);
+	result += "[1,[[\"MAIN\",";
+	Poco::NumberFormatter::append(result, ext_info.max_threads);
+	result += ",";
+	Poco::NumberFormatter::append(result, main_lane.queued.load());
+	result += ",";
+	Poco::NumberFormatter::append(result, main_lane.max_queued.load());
+	result += ",";
+	Poco::NumberFormatter::append(result, main_lane.active.load());
+	result += ",";
+	Poco::NumberFormatter::append(result, main_lane.completed.load());
+	result += "],[\"BULK\",";
+	Poco::NumberFormatter::append(result, ext_info.bulk_threads);
+	result += ",";
+	Poco::NumberFormatter::append(result, bulk_lane.queued.load());
+	result += ",";
+	Poco::NumberFormatter::append(result, bulk_lane.max_queued.load());
+	result += ",";
+	Poco::NumberFormatter::append(result, bulk_lane.active.load());
+	result += ",";
+	Poco::NumberFormatter::append(result, bulk_lane.completed.load());
+	result += "]]]";
+
+	if (result.length() <= output_size)
+	{
+		std::strcpy(output, result.c_str());
+	}
+	else
+	{
+		std::strcpy(output, "[0,\"Error Result Larger than Output Size\"]");
+	}
+}
+
+
 void Ext::onewayCallProtocol(std::string &input_str)
 // ASync callProtocol
 {
@@ -1385,7 +1997,8 @@ void Ext::onewayCallProtocol(std::string &input_str)
 		if (const_itr != unordered_map_protocol.end())
 		{
 			resultData result_data;
-			const_itr->second->callProtocol(input_str.substr(found+1), result_data.message, true);
+			input_str.erase(0, found+1); // Reuse input_str for Protocol Input, saves a copy
+			const_itr->second->callProtocol(std::move(input_str), result_data.message, true);
 		}
 	}
 }
@@ -1412,13 +2025,14 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 			logger->info("extDB2: Input from Server: {0}", std::string(function));
 		#endif
 
-		std::string input_str(function);
+		// No copy of input, only paths that queue work for later take a copy
+		const boost::string_ref input_str(function);
 		call_extension_input_str_length = input_str.length();
 
 		if (call_extension_input_str_length <= 2)
 		{
 			std::strcpy(output, "[0,\"Error Invalid Message\"]");
-			logger->info("extDB2: Invalid Message: {0}", input_str);
+			logger->info("extDB2: Invalid Message: {0}", function);
 		}
 		else
 		{
@@ -1427,53 +2041,71 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 			{
 				case '1': //ASYNC
 				{
-					io_service.post(boost::bind(&Ext::onewayCallProtocol, this, std::move(input_str)));
+					postWork(isBulkCall(input_str), boost::bind(&Ext::onewayCallProtocol, this, input_str.to_string()));
 					break;
 				}
 				case '2': //ASYNC + SAVE
 				{
 					// Protocol
-					const std::string::size_type found = input_str.find(":", 2);
+					const boost::string_ref::size_type found = input_str.substr(2).find(':');
 
-					if ((found==std::string::npos) || (found == (call_extension_input_str_length - 1)))
+					if ((found==boost::string_ref::npos) || ((found + 2) == (call_extension_input_str_length - 1)))
 					{
 						std::strcpy(output, "[0,\"Error Invalid Format\"]");
-						logger->error("extDB2: Error Invalid Format: {0}", input_str);
+						logger->error("extDB2: Error Invalid Format: {0}", function);
 					}
 					else
 					{
 						// Check for Protocol Name Exists...
 						// Do this so if someone manages to get server, the error message wont get stored in the result unordered map
-						const std::string protocol = input_str.substr(2,(found-2));
-						if (unordered_map_protocol.find(protocol) != unordered_map_protocol.end()) //TODO Change to ITER
+						std::string protocol = input_str.substr(2, found).to_string();
+						auto const_itr = unordered_map_protocol.find(protocol);
+						if (const_itr != unordered_map_protocol.end())
 						{
-							unsigned int unique_id;
+							const bool bulk = const_itr->second->isBulkCall(input_str.substr(found + 3));
+							const unsigned int unique_id = unique_id_counter++;
 							{
-								std::lock_guard<std::mutex> lock(mutex_results);
-								unique_id = unique_id_counter++;
-								stored_results[unique_id].wait = true;
+								resultShard &shard = getResultShard(unique_id);
+								std::lock_guard<std::mutex> lock(shard.mutex_results);
+								shard.stored_results[unique_id].wait = true;
 							}
-							io_service.post(boost::bind(&Ext::asyncCallProtocol, this, output_size, std::move(protocol), input_str.substr(found+1), std::move(unique_id)));
+							postWork(bulk, boost::bind(&Ext::asyncCallProtocol, this, output_size, std::move(protocol), input_str.substr(found + 3).to_string(), unique_id));
 							std::strcpy(output, ("[2,\"" + Poco::NumberFormatter::format(unique_id) + "\"]").c_str());
 						}
 						else
 						{
 							std::strcpy(output, "[0,\"Error Unknown Protocol\"]");
-							logger->error("extDB2: Error Unknown Protocol: {0}  Input String: {1}", protocol, input_str);
+							logger->error("extDB2: Error Unknown Protocol: {0}  Input String: {1}", protocol, function);
 						}
 					}
 					break;
 				}
 				case '4': // GET -- Single-Part Message Format
 				{
-					const unsigned int unique_id = Poco::NumberParser::parse(input_str.substr(2));
-					getSinglePartResult_mutexlock(output, output_size, unique_id);
+					unsigned int unique_id;
+					if (parseUniqueID(function, unique_id))
+					{
+						getSinglePartResult_mutexlock(output, output_size, unique_id);
+					}
+					else
+					{
+						std::strcpy(output, "[0,\"Error Invalid Format\"]");
+						logger->error("extDB2: Error Invalid Format: {0}", function);
+					}
 					break;
 				}
 				case '5': // GET -- Multi-Part Message Format
 				{
-					const unsigned int unique_id = Poco::NumberParser::parse(input_str.substr(2));
-					getMultiPartResult_mutexlock(output, output_size, unique_id);
+					unsigned int unique_id;
+					if (parseUniqueID(function, unique_id))
+					{
+						getMultiPartResult_mutexlock(output, output_size, unique_id);
+					}
+					else
+					{
+						std::strcpy(output, "[0,\"Error Invalid Format\"]");
+						logger->error("extDB2: Error Invalid Format: {0}", function);
+					}
 					break;
 				}
 				case '0': //SYNC
@@ -1483,10 +2115,11 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 				}
 				case '9': // SYSTEM CALLS / SETUP
 				{
-					Poco::StringTokenizer tokens(input_str, ":");
+					std::array<boost::string_ref, 6> tokens;
+					const std::size_t tokens_count = Tokenizer::split(input_str, ':', tokens);
 					if (ext_info.extDB_lock)
 					{
-						switch (tokens.count())
+						switch (tokens_count)
 						{
 							case 2:
 								if (tokens[1] == "VERSION")
@@ -1520,43 +2153,55 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 									getLocalDateTime(result);
 									std::strcpy(output, result.c_str());
 								}
+								else if (tokens[1] == "WORKER_STATS")
+								{
+									getWorkerStats(output, output_size);
+								}
 								else
 								{
 									std::strcpy(output, "[0,\"Error Invalid Format\"]");
-									logger->error("extDB2: Error Invalid Format: {0}", input_str);
+									logger->error("extDB2: Error Invalid Format: {0}", function);
 								}
 								break;
 							case 3:
 								if (tokens[1] == "TIME")
 								{
 									std::string result;
-									getDateTime(tokens[2], result);
+									getDateTime(tokens[2].to_string(), result);
 									std::strcpy(output, result.c_str());
 								}
 								else if (tokens[1] == "UPTIME")
 								{
 									std::string result;
-									getUPTime(tokens[2], result);
+									getUPTime(tokens[2].to_string(), result);
 									std::strcpy(output, result.c_str());
 								}
+								else if (tokens[1] == "PROTOCOL_STATS")
+								{
+									getProtocolStats(output, output_size, tokens[2].to_string());
+								}
+								else if (tokens[1] == "DATABASE_STATS")
+								{
+									getDatabaseStats(output, output_size, tokens[2].to_string());
+								}
 								break;
 							case 4:
 								if (tokens[1] == "TIMEDIFF_CURRENT")
 								{
 									std::string result;
-									getCurrentTimeDiff(tokens[2],tokens[3],result);
+									getCurrentTimeDiff(tokens[2].to_string(),tokens[3].to_string(),result);
 									std::strcpy(output, result.c_str());
 								}
 								else if (tokens[1] == "TIMEDIFF_CURRENT_LOCAL")
 								{
 									std::string result;
-									getCurrentTimeDiff(tokens[2],tokens[3],result);
+									getCurrentTimeDiff(tokens[2].to_string(),tokens[3].to_string(),result);
 									std::strcpy(output, result.c_str());
 								}
 								else if (tokens[1] == "DATEADD")
 								{
 									std::string result;
-									getDateAdd(tokens[2],tokens[3],result);
+									getDateAdd(tokens[2].to_string(),tokens[3].to_string(),result);
 									std::strcpy(output, result.c_str());
 								}
 								break;
@@ -1564,25 +2209,25 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 								if (tokens[1] == "TIMEDIFF")
 								{
 									std::string result;
-									getTimeDiff(tokens[2],tokens[3],tokens[4],result);
+									getTimeDiff(tokens[2].to_string(),tokens[3].to_string(),tokens[4].to_string(),result);
 									std::strcpy(output, result.c_str());
 								}
 								else if (tokens[1] == "TIMEDIFF_CURRENT")
 								{
 									std::string result;
-									getCurrentTimeDiff(tokens[2],tokens[3],tokens[4],result);
+									getCurrentTimeDiff(tokens[2].to_string(),tokens[3].to_string(),tokens[4].to_string(),result);
 									std::strcpy(output, result.c_str());
 								}
 								break;
 							default:
 								// Invalid Format
 								std::strcpy(output, "[0,\"Error Invalid Format\"]");
-								logger->error("extDB2: Error Invalid Format: {0}", input_str);
+								logger->error("extDB2: Error Invalid Format: {0}", function);
 						}
 					}
 					else
 					{
-						switch (tokens.count())
+						switch (tokens_count)
 						{
 							case 2:
 								// VAC
@@ -1642,6 +2287,10 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 									getLocalDateTime(result);
 									std::strcpy(output, result.c_str());
 								}
+								else if (tokens[1] == "WORKER_STATS")
+								{
+									getWorkerStats(output, output_size);
+								}
 								else if (tokens[1] == "VAR")
 								{
 									std::strcpy(output, ext_info.var.c_str());
@@ -1656,139 +2305,147 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 								else
 								{
 									std::strcpy(output, "[0,\"Error Invalid Format\"]");
-									logger->error("extDB2: Error Invalid Format: {0}", input_str);
+									logger->error("extDB2: Error Invalid Format: {0}", function);
 								}
 								break;
 							case 3:
 								// DATABASE
 								if (tokens[1] == "ADD_DATABASE")
 								{
-									connectDatabase(output, tokens[2], tokens[2]);
+									connectDatabase(output, tokens[2].to_string(), tokens[2].to_string());
 								}
 								/*
 								// BELOGSCANNER
 								else if (tokens[1] == "START_BELOGSCANNER")
 								{
-									startBELogscanner(output, tokens[2]);
+									startBELogscanner(output, tokens[2].to_string());
 								}
 								*/
 								// RCON
 								else if (tokens[1] == "START_RCON")
 								{
 									std::vector<std::string> extra_rcon_options;
-									startRcon(output, tokens[2], extra_rcon_options);
+									startRcon(output, tokens[2].to_string(), extra_rcon_options);
 								}
 								else if (tokens[1] == "TIME")
 								{
 									std::string result;
-									getDateTime(tokens[2], result);
+									getDateTime(tokens[2].to_string(), result);
 									std::strcpy(output, result.c_str());
 								}
 								else if (tokens[1] == "UPTIME")
 								{
 									std::string result;
-									getUPTime(tokens[2], result);
+									getUPTime(tokens[2].to_string(), result);
 									std::strcpy(output, result.c_str());
 								}
+								else if (tokens[1] == "PROTOCOL_STATS")
+								{
+									getProtocolStats(output, output_size, tokens[2].to_string());
+								}
+								else if (tokens[1] == "DATABASE_STATS")
+								{
+									getDatabaseStats(output, output_size, tokens[2].to_string());
+								}
 								else
 								{
 									// Invalid Format
 									std::strcpy(output, "[0,\"Error Invalid Format\"]");
-									logger->error("extDB2: Error Invalid Format: {0}", input_str);
+									logger->error("extDB2: Error Invalid Format: {0}", function);
 								}
 								break;
 							case 4:
 								if (tokens[1] == "TIMEDIFF_CURRENT")
 								{
 									std::string result;
-									getCurrentTimeDiff(tokens[2],tokens[3],result);
+									getCurrentTimeDiff(tokens[2].to_string(),tokens[3].to_string(),result);
 									std::strcpy(output, result.c_str());
 								}
 								else if (tokens[1] == "TIMEDIFF_CURRENT_LOCAL")
 								{
 									std::string result;
-									getCurrentTimeDiff(tokens[2],tokens[3],result);
+									getCurrentTimeDiff(tokens[2].to_string(),tokens[3].to_string(),result);
 									std::strcpy(output, result.c_str());
 								}
 								else if (tokens[1] == "DATEADD")
 								{
 									std::string result;
-									getDateAdd(tokens[2],tokens[3],result);
+									getDateAdd(tokens[2].to_string(),tokens[3].to_string(),result);
 									std::strcpy(output, result.c_str());
 								}
 								else if (tokens[1] == "ADD_DATABASE")
 								{
-									connectDatabase(output, tokens[2], tokens[3]);
+									connectDatabase(output, tokens[2].to_string(), tokens[3].to_string());
 								}
 								else if (tokens[1] == "ADD_PROTOCOL")
 								{
-									addProtocol(output, "", tokens[2], tokens[3], "");
+									addProtocol(output, "", tokens[2].to_string(), tokens[3].to_string(), "");
 								}
 								else if (tokens[1] == "START_RCON")
 								{
 									std::vector<std::string> extra_rcon_options;
-									extra_rcon_options.push_back(tokens[3]);
-									startRcon(output, tokens[2], extra_rcon_options);
+									extra_rcon_options.push_back(tokens[3].to_string());
+									startRcon(output, tokens[2].to_string(), extra_rcon_options);
 								}
 								else
 								{
 									// Invalid Format
 									std::strcpy(output, "[0,\"Error Invalid Format\"]");
-									logger->error("extDB2: Error Invalid Format: {0}", input_str);
+									logger->error("extDB2: Error Invalid Format: {0}", function);
 								}
 								break;
 						case 5:
 								if (tokens[1] == "TIMEDIFF")
 								{
 									std::string result;
-									getTimeDiff(tokens[2],tokens[3],tokens[4],result);
+									getTimeDiff(tokens[2].to_string(),tokens[3].to_string(),tokens[4].to_string(),result);
 									std::strcpy(output, result.c_str());
 								}
 								else if (tokens[1] == "TIMEDIFF_CURRENT")
 								{
 									std::string result;
-									getCurrentTimeDiff(tokens[2],tokens[3],tokens[4],result);
+									getCurrentTimeDiff(tokens[2].to_string(),tokens[3].to_string(),tokens[4].to_string(),result);
 									std::strcpy(output, result.c_str());
 								}
 								else if (tokens[1] == "ADD_PROTOCOL")
 								{
-									addProtocol(output, "", tokens[2], tokens[3], tokens[4]); // ADD + Init Options
+									addProtocol(output, "", tokens[2].to_string(), tokens[3].to_string(), tokens[4].to_string()); // ADD + Init Options
 								}
 								else if (tokens[1] == "ADD_DATABASE_PROTOCOL")
 								{
-									addProtocol(output, tokens[2], tokens[3], tokens[4], ""); // ADD Database Protocol + No Options
+									addProtocol(output, tokens[2].to_string(), tokens[3].to_string(), tokens[4].to_string(), ""); // ADD Database Protocol + No Options
 								}
 								else if (tokens[1] == "START_RCON")
 								{
 									std::vector<std::string> extra_rcon_options;
-									extra_rcon_options.push_back(tokens[3]);
-									extra_rcon_options.push_back(tokens[4]);
-									startRcon(output, tokens[2], extra_rcon_options);
+									extra_rcon_options.push_back(tokens[3].to_string());
+									extra_rcon_options.push_back(tokens[4].to_string());
+									startRcon(output, tokens[2].to_string(), extra_rcon_options);
 								}
 								else
 								{
 									// Invalid Format
 									std::strcpy(output, "[0,\"Error Invalid Format\"]");
-									logger->error("extDB2: Error Invalid Format: {0}", input_str);
+									logger->error("extDB2: Error Invalid Format: {0}", function);
 								}
 								break;
 							case 6:
 								if (tokens[1] == "ADD_DATABASE_PROTOCOL")
 								{
-									addProtocol(output, tokens[2], tokens[3], tokens[4], tokens[5]); // ADD Database Protocol + Options
+									addProtocol(output, tokens[2].to_string(), tokens[3].to_string(), tokens[4].to_string(), tokens[5].to_string()); // ADD Database Protocol + Options
 								}
 								else
 								{
 									// Invalid Format
 									std::strcpy(output, "[0,\"Error Invalid Format\"]");
-									logger->error("extDB2: Error Invalid Format: {0}", input_str);
+									logger->error("extDB2: Error Invalid Format: {0}", function);
 								}
 								break;
 							default:
 								{
 									// Invalid Format
 									std::strcpy(output, "[0,\"Error Invalid Format\"]");
-									logger->error("extDB2: Error Invalid Format: {0}", input_str);
+									logger->error("extDB2: Error Invalid Format: {0}", function);
 								}
 						}
 					}
@@ -1797,7 +2454,7 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 				default:
 				{
 					std::strcpy(output, "[0,\"Error Invalid Message\"]");
-					logger->error("extDB2: Error Invalid Message: {0}", input_str);
+					logger->error("extDB2: Error Invalid Message: {0}", function);
 				}
 			}
 		}
@@ -1825,6 +2482,265 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 
 #if defined(TEST_APP) && defined(DEBUG_TESTING)
 
+	void Ext::benchmarkMultiPartResult()
+	// Times Multi-Part retrieval for increasing result sizes, cost per chunk should stay flat
+	//   Chunks == 5: Calls needed, client does at most one per frame if it sleeps between them
+	{
+		char output[20481] = {0};
+		const int output_sizes[] = {10240, 20480};
+		const std::size_t result_sizes[] = {10240, 102400, 1048576, 10485760, 52428800};
+
+		for (auto &output_size : output_sizes)
+		{
+			for (auto &result_size : result_sizes)
+			{
+				resultData result_data;
+				result_data.message.assign(result_size, 'x');
+				const unsigned int unique_id = saveResult_mutexlock(result_data);
+
+				getSinglePartResult_mutexlock(output, output_size, unique_id);
+				const std::string reply(output);
+
+				int chunks = 0;
+				auto start = std::chrono::high_resolution_clock::now();
+				while (true)
+				{
+					getMultiPartResult_mutexlock(output, output_size, unique_id);
+					if (output[0] == '\0')
+					{
+						break;
+					}
+					++chunks;
+				}
+				auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+				console->info("extDB2: Multi-Part Benchmark: Output Size: {0} Result Size: {1} Reply: {2} Chunks: {3} Total: {4}us Per Chunk: {5}us", output_size, result_size, reply, chunks, elapsed, (chunks > 0 ? (elapsed / chunks) : 0));
+			}
+		}
+	}
+
+
+	extern std::atomic<std::size_t> allocation_counter; // memory_allocator.cpp
+
+	void Ext::benchmarkCallParsing()
+	// Counts Heap Allocations per callExtension for common Call Strings
+	{
+		const int output_size = 10240;
+		char output[10241] = {0};
+		const int iterations = 100000;
+
+		callExtension(output, output_size, "9:ADD_PROTOCOL:MISC:BENCHMARK_MISC");
+		const std::string unique_id = Poco::NumberFormatter::format(unique_id_counter.load());
+		const std::vector<std::string> call_strs = {
+			("4:" + unique_id),
+			("5:" + unique_id),
+			"9:VERSION",
+			"9:LOCK_STATUS",
+			"9:UPTIME:SECONDS",
+			"0:BENCHMARK_MISC:TIME",
+			"0:UNKNOWN_PROTOCOL:TIME"
+		};
+
+		for (auto &call_str : call_strs)
+		{
+			const std::size_t allocations_start = allocation_counter.load();
+			auto start = std::chrono::high_resolution_clock::now();
+			for (int i = 0; i < iterations; ++i)
+			{
+				callExtension(output, output_size, call_str.c_str());
+			}
+			auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+			const std::size_t allocations = allocation_counter.load() - allocations_start;
+			console->info("extDB2: Call Parsing Benchmark: {0} Allocations Per Call: {1} Per Call: {2}ns", call_str, (static_cast<double>(allocations) / iterations), ((elapsed * 1000) / iterations));
+		}
+	}
+
+
+	void Ext::benchmarkQueries(const std::string &call_str)
+	// Queries per Second for Async Calls i.e SQL:getPlayer:76561198000000000, compare different Main.Threads / Main.Thread Limit
+	{
+		const int output_size = 10240;
+		char output[10241] = {0};
+		const int queries = 10000;
+		const std::string async_call_str = "2:" + call_str;
+
+		std::vector<unsigned int> unique_ids;
+		unique_ids.reserve(queries);
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < queries; ++i)
+		{
+			callExtension(output, output_size, async_call_str.c_str());
+			if (std::strncmp(output, "[2,\"", 4) != 0)
+			{
+				console->warn("extDB2: Query Benchmark: Error: {0}", output);
+				return;
+			}
+			unique_ids.push_back(std::strtoul(output + 4, nullptr, 10));
+		}
+		int errors = 0;
+		for (auto &unique_id : unique_ids)
+		{
+			while (true)
+			{
+				getSinglePartResult_mutexlock(output, output_size, unique_id);
+				if (std::strcmp(output, "[3]") == 0)
+				{
+					std::this_thread::yield();
+				}
+				else if (std::strcmp(output, "[5]") == 0)
+				{
+					do
+					{
+						getMultiPartResult_mutexlock(output, output_size, unique_id);
+					} while (output[0] != '\0');
+					break;
+				}
+				else
+				{
+					if (std::strncmp(output, "[1", 2) != 0)
+					{
+						++errors;
+					}
+					break;
+				}
+			}
+		}
+		auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+		console->info("extDB2: Query Benchmark: {0} Queries: {1} Errors: {2} Worker Threads: {3} Total: {4}ms Queries/sec: {5}", call_str, queries, errors, ext_info.max_threads, (elapsed / 1000), ((static_cast<long long>(queries) * 1000000) / std::max<long long>(1, elapsed)));
+	}
+
+
+	void Ext::benchmarkResults(const std::string &call_str)
+	// Result Size + Time for Sync Calls i.e SQL:getAllVehicles, compare Output Format SQF / Simple Array / Columnar on a large result
+	//   Parse Time is Sqf::check over the result, a stand in for the client parsing it (call compile / parseSimpleArray)
+	{
+		const int calls = 10;
+		const std::string::size_type found = call_str.find(':');
+		auto const_itr = unordered_map_protocol.find(call_str.substr(0, found));
+		if ((found == std::string::npos) || (const_itr == unordered_map_protocol.end()))
+		{
+			console->warn("extDB2: Result Benchmark: Error Unknown Protocol: {0}", call_str);
+			return;
+		}
+		const std::string protocol_input_str = call_str.substr(found + 1);
+
+		std::string result;
+		long long call_elapsed = 0;
+		long long parse_elapsed = 0;
+		bool parse_status = true;
+		for (int i = 0; i < calls; ++i)
+		{
+			result.clear();
+			auto start = std::chrono::high_resolution_clock::now();
+			const_itr->second->callProtocol(protocol_input_str, result, false);
+			auto parse_start = std::chrono::high_resolution_clock::now();
+			parse_status = Sqf::check(result);
+			auto parse_end = std::chrono::high_resolution_clock::now();
+			call_elapsed += std::chrono::duration_cast<std::chrono::microseconds>(parse_start - start).count();
+			parse_elapsed += std::chrono::duration_cast<std::chrono::microseconds>(parse_end - parse_start).count();
+		}
+		console->info("extDB2: Result Benchmark: {0} Calls: {1} Result Size: {2} bytes Call (Query + Serialize): {3}us Parse: {4}us Parse Status: {5}", call_str, calls, result.size(), (call_elapsed / calls), (parse_elapsed / calls), parse_status);
+	}
+
+
+	void Ext::benchmarkBELogScanner(const std::string &path_str)
+	// Filter Lines/sec for a BattlEye Log, BELogScanner doesn't need to be started
+	{
+		belog_scanner.benchmarkFilters(this, path_str);
+	}
+
+
+	void Ext::benchmarkUniqueStrings()
+	// 100k Unique Strings via MISC RANDOM_UNIQUE_STRING Calls (10 Strings per Call), 1 Thread vs 4 Threads
+	{
+		const int strings = 100000;
+		const int strings_per_call = 10;
+		for (int num_of_threads : {1, 4})
+		{
+			const std::size_t start_size = unique_random_strings.size();
+			std::vector<std::thread> benchmark_threads;
+			auto start = std::chrono::high_resolution_clock::now();
+			for (int t = 0; t < num_of_threads; ++t)
+			{
+				benchmark_threads.push_back(std::thread([this, num_of_threads, strings, strings_per_call]()
+				{
+					std::string result;
+					for (int i = 0; i < (strings / strings_per_call / num_of_threads); ++i)
+					{
+						int len_of_string = 8;
+						int num_of_strings = strings_per_call;
+						getUniqueString(len_of_string, num_of_strings, result);
+					}
+				}));
+			}
+			for (auto &benchmark_thread : benchmark_threads)
+			{
+				benchmark_thread.join();
+			}
+			auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+			console->info("extDB2: Unique Strings Benchmark: Threads: {0} Strings: {1} Total: {2}ms Strings/sec: {3} Stored: {4} (Unique Strings Max: {5})", num_of_threads, (unique_random_strings.size() - start_size), (elapsed / 1000), ((static_cast<long long>(strings) * 1000000) / std::max<long long>(1, elapsed)), unique_random_strings.size(), unique_random_strings_max);
+		}
+	}
+
+
+	void Ext::benchmarkBEGUID()
+	// SteamID -> BEGUID Conversions/sec across 8 Threads, Lock-Free Hash::getBEGUID vs one Mutex guarded MD5Engine (old)
+	{
+		const int num_of_threads = 8;
+		const int conversions = 100000; // per Thread
+		Poco::MD5Engine locked_md5;
+		std::mutex mutex_locked_md5;
+
+		for (bool locked : {true, false})
+		{
+			std::vector<std::thread> benchmark_threads;
+			auto start = std::chrono::high_resolution_clock::now();
+			for (int t = 0; t < num_of_threads; ++t)
+			{
+				benchmark_threads.push_back(std::thread([&locked_md5, &mutex_locked_md5, locked, t, conversions]()
+				{
+					std::string steam_id;
+					std::string beguid;
+					for (int i = 0; i < conversions; ++i)
+					{
+						steam_id = Poco::NumberFormatter::format(76561197960265728LL + (static_cast<Poco::Int64>(t) * conversions) + i);
+						if (locked)
+						{
+							Poco::UInt64 steamID = Poco::NumberParser::parseUnsigned64(steam_id);
+							char bestring[10] = { 'B', 'E' };
+							for (int x = 0; x < 8; ++x)
+							{
+								bestring[x + 2] = static_cast<char>(steamID & 0xFFu);
+								steamID >>= 8;
+							}
+							std::lock_guard<std::mutex> lock(mutex_locked_md5);
+							locked_md5.update(bestring, sizeof(bestring));
+							beguid = Poco::DigestEngine::digestToHex(locked_md5.digest());
+						}
+						else
+						{
+							Hash::getBEGUID(steam_id, beguid);
+						}
+					}
+				}));
+			}
+			for (auto &benchmark_thread : benchmark_threads)
+			{
+				benchmark_thread.join();
+			}
+			auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+			console->info("extDB2: BEGUID Benchmark: {0} Threads: {1} Conversions: {2} Total: {3}ms Conversions/sec: {4}", (locked ? "Mutex MD5Engine" : "Lock-Free"), num_of_threads, (num_of_threads * conversions), (elapsed / 1000), ((static_cast<long long>(num_of_threads) * conversions * 1000000) / std::max<long long>(1, elapsed)));
+		}
+	}
+
+
+	void Ext::benchmarkSteamJSON(const std::string &path_str)
+	// Parse Time + Peak Memory for a recorded Steam Web API Response i.e GetPlayerBans for 100 SteamIDs
+	{
+		steam.benchmarkJSON(path_str);
+	}
+
+
 	int main(int nNumberofArgs, char* pszArgs[])
 	{
 		int result_size = 80;
@@ -1873,6 +2789,38 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 			{
 				test = true;
 			}
+			else if (boost::algorithm::iequals(input_str, "Test Multipart") == 1)
+			{
+				extension->benchmarkMultiPartResult();
+			}
+			else if (boost::algorithm::iequals(input_str, "Test Parsing") == 1)
+			{
+				extension->benchmarkCallParsing();
+			}
+			else if (boost::algorithm::istarts_with(input_str, "Test Queries "))
+			{
+				extension->benchmarkQueries(input_str.substr(13));
+			}
+			else if (boost::algorithm::istarts_with(input_str, "Test Results "))
+			{
+				extension->benchmarkResults(input_str.substr(13));
+			}
+			else if (boost::algorithm::istarts_with(input_str, "Test BELog "))
+			{
+				extension->benchmarkBELogScanner(input_str.substr(11));
+			}
+			else if (boost::algorithm::iequals(input_str, "Test Unique Strings") == 1)
+			{
+				extension->benchmarkUniqueStrings();
+			}
+			else if (boost::algorithm::iequals(input_str, "Test BEGUID") == 1)
+			{
+				extension->benchmarkBEGUID();
+			}
+			else if (boost::algorithm::istarts_with(input_str, "Test Steam JSON "))
+			{
+				extension->benchmarkSteamJSON(input_str.substr(16));
+			}
 			else
 			{
 				extension->callExtension(result, result_size, input_str.c_str());
@@ -18,14 +18,24 @@ along with this program. If not, see <http://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <boost/asio.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/random/mersenne_twister.hpp>
 #include <boost/random/random_device.hpp>
 #include <boost/random/uniform_int_distribution.hpp>
 #include <boost/thread/thread.hpp>
+#include <boost/thread/tss.hpp>
+#include <boost/utility/string_ref.hpp>
 
 #include <Poco/Data/SessionPool.h>
 
@@ -55,22 +65,37 @@ class Ext: public AbstractExt
 		void createPlayerKey_mutexlock(std::string &player_beguid, int len_of_key);
 
 		void delPlayerKey_delayed(std::string &player_beguid);
-		void delPlayerKey_mutexlock();
+		void delPlayerKey_mutexlock(const boost::system::error_code &error);
 
 		void getPlayerKey_SteamID(std::string &player_steam_id, std::string &player_key);
 		void getPlayerKey_BEGuid(std::string &player_beguid, std::string &player_key);
 		std::string getPlayerRegex_BEGuid(std::string &player_beguid);
 
+		#if defined(TEST_APP) && defined(DEBUG_TESTING)
+			void benchmarkMultiPartResult();
+			void benchmarkCallParsing();
+			void benchmarkQueries(const std::string &call_str);
+			void benchmarkResults(const std::string &call_str);
+			void benchmarkBELogScanner(const std::string &path_str);
+			void benchmarkUniqueStrings();
+			void benchmarkBEGUID();
+			void benchmarkSteamJSON(const std::string &path_str);
+		#endif
+
 	protected:
-		const unsigned int saveResult_mutexlock(const resultData &result_data);
-		void saveResult_mutexlock(const unsigned int &unique_id, const resultData &result_data);
-		void saveResult_mutexlock(std::vector<unsigned int> &unique_ids, const resultData &result_data);
+		const unsigned int saveResult_mutexlock(resultData &result_data);
+		void saveResult_mutexlock(const unsigned int &unique_id, resultData &result_data);
+		void saveResult_mutexlock(std::vector<unsigned int> &unique_ids, resultData &result_data);
 
 		Poco::Thread steam_thread;
 
+		AbstractExt::DBConnectionInfo &getReadDBConnection(AbstractExt::DBConnectionInfo &database);
 		Poco::Data::Session getDBSession_mutexlock(AbstractExt::DBConnectionInfo &database);
 		Poco::Data::Session getDBSession_mutexlock(AbstractExt::DBConnectionInfo &database, Poco::Data::SessionPool::SessionDataPtr &session_data_ptr);
 
+		boost::asio::io_service &getIOService();
+		boost::asio::io_service &getBulkIOService();
+
 		void steamQuery(const unsigned int &unique_id, bool queryFriends, bool queryVacBans, std::string &steamID, bool wakeup);
 		void steamQuery(const unsigned int &unique_id, bool queryFriends, bool queryVacBans, std::vector<std::string> &steamIDs, bool wakeup);
 
@@ -78,14 +103,25 @@ class Ext: public AbstractExt
 		// Input
 		std::string::size_type input_str_length;
 
+		// Player Keys, Copy-on-Write Snapshot
+		//   Readers (SQL_CUSTOM_V2 result loops, BELogScanner) atomic load the current map, no mutex
+		//   Writers (Rcon player join / leave) copy + swap the map under player_unique_keys_mutex
 		struct PlayerKeys
 		{
-			std::list<std::string> keys;
+			std::vector<std::string> keys; // Oldest first
 			std::string regex_rule;
 		};
-		std::unordered_map<std::string, PlayerKeys> player_unique_keys;
-		std::list< std::pair<std::size_t, std::string> > del_players_keys;
-		// std::mutex player_unique_keys_mutex;  defined in abstract_ext.h  used by BELogscanner
+		typedef std::unordered_map<std::string, PlayerKeys> PlayerKeysMap;
+		std::shared_ptr<const PlayerKeysMap> player_unique_keys = std::make_shared<PlayerKeysMap>();
+		std::mutex player_unique_keys_mutex;
+
+		// Delayed Player Key Removal, Timer Wheel with 1 second slots
+		std::array<std::vector<std::string>, 32> player_keys_wheel;
+		std::size_t player_keys_wheel_pos = 0;
+		std::size_t player_keys_wheel_count = 0;
+		bool player_keys_timer_active = false; // player_keys_timer is declared after io_service
+
+		void updatePlayerRegex(PlayerKeys &player_keys);
 
 		// Rcon
 		std::unique_ptr<Rcon> rcon;
@@ -96,11 +132,67 @@ class Ext: public AbstractExt
 		// Steam
 		Steam steam;
 
-		// Main ASIO Thread Queue
+		// Main ASIO Thread Queue (Main Worker Lane)
 		std::unique_ptr<boost::asio::io_service::work> io_work_ptr;
 		boost::asio::io_service io_service;
 		boost::thread_group threads;
-		std::unique_ptr<boost::asio::deadline_timer> timer;
+
+		// Delayed Player Key Removal Timer, declared after io_service so it is destroyed before io_service
+		std::unique_ptr<boost::asio::deadline_timer> player_keys_timer;
+
+		// Bulk ASIO Thread Queue (Bulk Worker Lane)
+		//   Bulk Protocols / Custom Calls only get Bulk Threads, so bulk saves can't starve latency sensitive calls on the Main Lane
+		std::unique_ptr<boost::asio::io_service::work> bulk_io_work_ptr;
+		boost::asio::io_service bulk_io_service;
+		boost::thread_group bulk_threads;
+
+		// Worker Lane Stats
+		struct workerLane
+		{
+			workerLane() : queued(0), max_queued(0), active(0), completed(0) {}
+			std::atomic<unsigned int> queued; // Posted, not started yet
+			std::atomic<unsigned int> max_queued;
+			std::atomic<unsigned int> active;
+			std::atomic<unsigned int> completed;
+		};
+		workerLane main_lane;
+		workerLane bulk_lane;
+
+		template <typename Handler>
+		struct workerLaneHandler
+		{
+			workerLane *lane;
+			Handler handler;
+
+			void operator()()
+			{
+				--(lane->queued);
+				++(lane->active);
+				handler();
+				--(lane->active);
+				++(lane->completed);
+			}
+		};
+
+		template <typename Handler>
+		void postWork(const bool bulk, Handler handler)
+		// Posts work to Main / Bulk Worker Lane
+		{
+			workerLane &lane = bulk ? bulk_lane : main_lane;
+			const unsigned int queued = ++(lane.queued);
+			unsigned int max_queued = lane.max_queued;
+			while ((queued > max_queued) && !(lane.max_queued.compare_exchange_weak(max_queued, queued)));
+
+			workerLaneHandler<Handler> lane_handler = { &lane, std::move(handler) };
+			if (bulk)
+			{
+				bulk_io_service.post(std::move(lane_handler));
+			}
+			else
+			{
+				io_service.post(std::move(lane_handler));
+			}
+		};
 
 		// Rcon ASIO Thread Queue
 		std::unique_ptr<boost::asio::io_service::work> rcon_io_work_ptr;
@@ -112,22 +204,32 @@ class Ext: public AbstractExt
 		std::mutex mutex_unordered_map_protocol;
 
 		// Unique Random String
+		//   Generated with a per Thread RNG, only the uniqueness check (hash set) is locked
+		//   Main.Unique Strings Max > 0, oldest MISC Strings are recycled once reached (Player Keys are freed once removed)
 		std::string random_chars;
-		boost::random::random_device random_chars_rng;
+		boost::random::random_device random_chars_rng; // Seeds per Thread RNG
+		boost::thread_specific_ptr<boost::random::mt19937> random_string_rng;
 		std::mutex mutex_RandomString;
-		std::vector < std::string > uniqueRandomVarNames;
+		std::unordered_set<std::string> unique_random_strings;
+		std::deque<std::string> unique_random_strings_order; // Oldest first, only used with Unique Strings Max
+		std::size_t unique_random_strings_max = 0;
+
+		void getRandomString(std::string &random_string, const int &len_of_string);
+		bool addUniqueString_mutexlock(const std::string &random_string, const bool recycle);
 
 		// Unique ID
 		std::string::size_type call_extension_input_str_length;
-		unsigned int unique_id_counter = 100; // Can't be value 1
+		std::atomic<unsigned int> unique_id_counter; // Can't be value 1
 
 		// Results
-		std::unordered_map<unsigned int, resultData> stored_results;
-		std::mutex mutex_results;  // Using Same Lock for Unique ID aswell
-
-		// Player Key
-		Poco::MD5Engine md5;
-		std::mutex mutex_md5;
+		//   Sharded by Unique ID, so the game thread polling for a result only waits on workers saving into the same shard
+		struct resultShard
+		{
+			std::unordered_map<unsigned int, resultData> stored_results;
+			std::mutex mutex_results;
+		};
+		std::array<resultShard, 16> results_shards;
+		resultShard &getResultShard(const unsigned int &unique_id);
 
 		// Timestamp
 		Poco::Timestamp timestamp;
@@ -153,18 +255,24 @@ class Ext: public AbstractExt
 		// Time
 		void getDateTime(const std::string &input_str, std::string &result);
 		void getLocalDateTime(std::string &result);
-		void getUPTime(std::string &token, std::string &result);
-		void getDateAdd(std::string& time1, std::string& time2, std::string &result);
-		void getTimeDiff(std::string &type, std::string& time1, std::string& time2, std::string &result);
-		void getCurrentTimeDiff(std::string &type, std::string& time1, std::string &result);
-		void getCurrentLocalTimeDiff(std::string &type, std::string& time1, std::string &result);
-		void getCurrentTimeDiff(std::string &type, std::string &time1, std::string &offset, std::string &result);
+		void getUPTime(const std::string &token, std::string &result);
+		void getDateAdd(const std::string &time1, std::string input_str, std::string &result);
+		void getTimeDiff(const std::string &type, const std::string &time1, const std::string &time2, std::string &result);
+		void getCurrentTimeDiff(const std::string &type, const std::string &time1, std::string &result);
+		void getCurrentLocalTimeDiff(const std::string &type, const std::string &time1, std::string &result);
+		void getCurrentTimeDiff(const std::string &type, const std::string &time1, const std::string &offset, std::string &result);
 
 		// BELogScanner
 		void startBELogscanner(char *output, const std::string &conf);
 
 		// Database
 		void connectDatabase(char *output, const std::string &database_conf, const std::string &database_id);
+		void addDBSessionWait(AbstractExt::DBConnectionInfo &database, const std::chrono::steady_clock::time_point &start);
+		bool startDBSessionPool(AbstractExt::DBConnectionInfo &database, const std::string &database_conf);
+		void maintainDBSessionPool(AbstractExt::DBConnectionInfo *database_ptr, const boost::system::error_code &error);
+		void stopDBSessionPoolMaintenance(AbstractExt::DBConnectionInfo &database);
+		void checkReplicaLag(AbstractExt::DBConnectionInfo &database);
+		void getDatabaseStats(char *output, const int &output_size, const std::string &database_id);
 		void getSinglePartResult_mutexlock(char *output, const int &output_size, const unsigned int &unique_id);
 		void getMultiPartResult_mutexlock(char *output, const int &output_size, const unsigned int &unique_id);
 
@@ -173,7 +281,13 @@ class Ext: public AbstractExt
 
 		// Protocols
 		void addProtocol(char *output, const std::string &database_id, const std::string &protocol, const std::string &protocol_name, const std::string &init_data);
-		void syncCallProtocol(char *output, const int &output_size, std::string &input_str);
+		bool parseUniqueID(const char *function, unsigned int &unique_id);
+		void syncCallProtocol(char *output, const int &output_size, const boost::string_ref &input_str);
 		void onewayCallProtocol(std::string &input_str);
 		void asyncCallProtocol(const int &output_size, const std::string &protocol, const std::string &data, const unsigned int unique_id);
+		void getProtocolStats(char *output, const int &output_size, const std::string &protocol_name);
+		bool isBulkCall(const boost::string_ref &input_str);
+
+		// Worker Lanes
+		void getWorkerStats(char *output, const int &output_size);
 };
@@ -0,0 +1,110 @@
+/*
+Copyright (C) 2014 Declan Ireland <http://github.com/torndeco/extDB2>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+getBEGUID --
+Code to Convert SteamID -> BEGUID
+From Frank https://gist.github.com/Fank/11127158
+*/
+
+
+#include "hash.h"
+
+#include <cctype>
+
+#include <boost/crc.hpp>
+
+#include <Poco/DigestEngine.h>
+#include <Poco/MD4Engine.h>
+#include <Poco/MD5Engine.h>
+#include <Poco/NumberFormatter.h>
+#include <Poco/NumberParser.h>
+#include <Poco/Types.h>
+
+
+namespace
+{
+	const char hex_chars[] = "0123456789abcdef";
+
+	void digestToHex(const Poco::DigestEngine::Digest &digest, std::string &result)
+	// Poco::DigestEngine::digestToHex without the temporary string
+	{
+		result.resize(digest.size() * 2);
+		for (std::size_t i = 0; i < digest.size(); ++i)
+		{
+			result[i * 2] = hex_chars[(digest[i] >> 4) & 0xF];
+			result[(i * 2) + 1] = hex_chars[digest[i] & 0xF];
+		}
+	}
+}
+
+
+void Hash::crc32(const std::string &input_str, std::string &result)
+{
+	boost::crc_32_type crc32;
+	crc32.process_bytes(input_str.data(), input_str.length());
+	result = Poco::NumberFormatter::format(crc32.checksum());
+}
+
+
+void Hash::md4(const std::string &input_str, std::string &result)
+{
+	Poco::MD4Engine md4;
+	md4.update(input_str);
+	digestToHex(md4.digest(), result);
+}
+
+
+void Hash::md5(const std::string &input_str, std::string &result)
+{
+	Poco::MD5Engine md5;
+	md5.update(input_str);
+	digestToHex(md5.digest(), result);
+}
+
+
+bool Hash::getBEGUID(const std::string &steam_id, std::string &beguid)
+{
+	if ((steam_id.empty()) || (steam_id.size() > 20))
+	{
+		return false;
+	}
+	for (auto &steam_id_char : steam_id)
+	{
+		if (!std::isdigit(static_cast<unsigned char>(steam_id_char)))
+		{
+			return false;
+		}
+	}
+	Poco::UInt64 steamID;
+	if (!Poco::NumberParser::tryParseUnsigned64(steam_id, steamID))
+	{
+		return false;
+	}
+
+	// "BE" + SteamID as 8 bytes little endian
+	char bestring[10] = { 'B', 'E' };
+	for (int i = 0; i < 8; ++i)
+	{
+		bestring[i + 2] = static_cast<char>(steamID & 0xFFu);
+		steamID >>= 8;
+	}
+
+	Poco::MD5Engine md5;
+	md5.update(bestring, sizeof(bestring));
+	digestToHex(md5.digest(), beguid);
+	return true;
+}
@@ -0,0 +1,34 @@
+/*
+Copyright (C) 2014 Declan Ireland <http://github.com/torndeco/extDB2>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <string>
+
+
+namespace Hash
+{
+	// Stateless, each call uses its own Engine on the stack, safe to call from any Thread without locking
+	void crc32(const std::string &input_str, std::string &result);
+	void md4(const std::string &input_str, std::string &result);
+	void md5(const std::string &input_str, std::string &result);
+
+	// SteamID -> BEGUID, returns false if steam_id isn't a valid SteamID
+	//   steam_id + beguid can be the same string
+	bool getBEGUID(const std::string &steam_id, std::string &beguid);
+}
@@ -12,11 +12,41 @@
 
 // Code is from Intel threading building blocks
 
+#if defined(TEST_APP) && defined(DEBUG_TESTING)
+	// Allocation Counter + Live / Peak Bytes for Test App Benchmarks
+	#include <atomic>
+	std::atomic<std::size_t> allocation_counter(0);
+	std::atomic<std::size_t> allocation_bytes_live(0);
+	std::atomic<std::size_t> allocation_bytes_peak(0); // Benchmarks reset to allocation_bytes_live before measuring
+
+	inline void countAllocationBytes(void *ptr)
+	{
+		if (ptr != NULL)
+		{
+			std::size_t live = (allocation_bytes_live += scalable_msize(ptr));
+			std::size_t peak = allocation_bytes_peak.load();
+			while ((live > peak) && (!(allocation_bytes_peak.compare_exchange_weak(peak, live))))
+			{
+			}
+		}
+	}
+
+	#define COUNT_ALLOCATION() ++allocation_counter
+	#define COUNT_ALLOCATION_BYTES(ptr) countAllocationBytes(ptr)
+	#define COUNT_FREE_BYTES(ptr) allocation_bytes_live -= scalable_msize(ptr)
+#else
+	#define COUNT_ALLOCATION()
+	#define COUNT_ALLOCATION_BYTES(ptr)
+	#define COUNT_FREE_BYTES(ptr)
+#endif
+
 
 void* operator new (size_t size)
 {
 	if (size == 0) size = 1;
+	COUNT_ALLOCATION();
 	void* ptr = scalable_malloc(size);
+	COUNT_ALLOCATION_BYTES(ptr);
 	if (ptr == NULL)
 	{
 		throw std::bad_alloc();
@@ -26,7 +56,9 @@ void* operator new (size_t size)
 
 void* operator new[] (size_t size)
 {
+	COUNT_ALLOCATION();
 	void* ptr = scalable_malloc(size);
+	COUNT_ALLOCATION_BYTES(ptr);
 	if (ptr == NULL)
 	{
 		throw std::bad_alloc();
@@ -37,7 +69,9 @@ void* operator new[] (size_t size)
 void* operator new (size_t size, const std::nothrow_t&)
 {
 	if (size == 0) size = 1;
+	COUNT_ALLOCATION();
 	void* ptr = scalable_malloc(size);
+	COUNT_ALLOCATION_BYTES(ptr);
 	if (ptr == NULL)
 	{
 		return ptr;
@@ -50,7 +84,9 @@ void* operator new (size_t size, const std::nothrow_t&)
 
 void* operator new[] (size_t size, const std::nothrow_t&)
 {
+	COUNT_ALLOCATION();
 	void* ptr = scalable_malloc(size);
+	COUNT_ALLOCATION_BYTES(ptr);
 	if (ptr == NULL)
 	{
 		return ptr;
@@ -65,6 +101,7 @@ void operator delete (void* ptr)
 {
 	if (ptr != NULL)
 	{
+		COUNT_FREE_BYTES(ptr);
 		scalable_free(ptr);
 	}
 }
@@ -78,6 +115,7 @@ void operator delete (void* ptr, const std::nothrow_t&)
 {
 	if (ptr != NULL)
 	{
+		COUNT_FREE_BYTES(ptr);
 		scalable_free(ptr);
 	}
 }
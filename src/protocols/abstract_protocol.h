@@ -18,6 +18,8 @@ along with this program. If not, see <http://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include <boost/utility/string_ref.hpp>
+
 #include "../abstract_ext.h"
 
 class AbstractProtocol
@@ -28,7 +30,11 @@ class AbstractProtocol
 
 		virtual bool init(AbstractExt *extension, const std::string &database_id, const std::string &init_str)=0;
 		virtual bool callProtocol(std::string input_str, std::string &result, const bool async_method, const unsigned int unique_id=1)=0;
+		virtual void getStats(std::string &result) { result = "[0,\"Error No Stats For Protocol\"]"; };
+		virtual bool isBulkCall(const boost::string_ref &input_str) { return bulk; }; // Async Calls run on Bulk Worker Lane
 
 		AbstractExt *extension_ptr;
 		AbstractExt::DBConnectionInfo *database_ptr;
+
+		bool bulk = false;
 };
@@ -13,11 +13,6 @@ GNU General Public License for more details.
 
 You should have received a copy of the GNU General Public License
 along with this program. If not, see <http://www.gnu.org/licenses/>.
-
-getGUID --
-Code to Convert SteamID -> BEGUID
-From Frank https://gist.github.com/Fank/11127158
-
 */
 
 #include "misc.h"
@@ -25,17 +20,15 @@ From Frank https://gist.github.com/Fank/11127158
 #include <cstdlib>
 #include <thread>
 
-#include <boost/crc.hpp>
 #include <boost/random/random_device.hpp>
 #include <boost/random/uniform_int_distribution.hpp>
 
-#include <Poco/DigestEngine.h>
 #include <Poco/NumberFormatter.h>
 #include <Poco/NumberParser.h>
-#include <Poco/MD4Engine.h>
-#include <Poco/MD5Engine.h>
 #include <Poco/StringTokenizer.h>
 
+#include "../hash.h"
+
 
 bool MISC::init(AbstractExt *extension, const std::string &database_id, const std::string &init_str)
 {
@@ -62,73 +55,34 @@ void MISC::getDateTime(const std::string &input_str, std::string &result)
 
 void MISC::getCrc32(std::string &input_str, std::string &result)
 {
-	std::lock_guard<std::mutex> lock(mutex_crc32);
-	crc32.reset();
-	crc32.process_bytes(input_str.data(), input_str.length());
-	result = "[1,\"" + Poco::NumberFormatter::format(crc32.checksum()) + "\"]";
+	Hash::crc32(input_str, result);
+	result = "[1,\"" + result + "\"]";
 }
 
 
 void MISC::getMD4(std::string &input_str, std::string &result)
 {
-	std::lock_guard<std::mutex> lock(mutex_md4);
-	md4.update(input_str);
-	result = "[1,\"" + Poco::DigestEngine::digestToHex(md4.digest()) + "\"]";
+	Hash::md4(input_str, result);
+	result = "[1,\"" + result + "\"]";
 }
 
 
 void MISC::getMD5(std::string &input_str, std::string &result)
 {
-	std::lock_guard<std::mutex> lock(mutex_md5);
-	md5.update(input_str);
-	result = "[1,\"" + Poco::DigestEngine::digestToHex(md5.digest()) + "\"]";
+	Hash::md5(input_str, result);
+	result = "[1,\"" + result + "\"]";
 }
 
 
 void MISC::getBEGUID(std::string &input_str, std::string &result)
-// From Frank https://gist.github.com/Fank/11127158
-// Modified to use libpoco
 {
-	bool status = true;
-
-	if (input_str.empty())
+	if (Hash::getBEGUID(input_str, result))
 	{
-		status = false;
-		result = "[0,\"Invalid SteamID\"";
+		result = "[1,\"" + result + "\"]";
 	}
 	else
 	{
-		for (unsigned int index=0; index < input_str.length(); index++)
-		{
-			if (!std::isdigit(input_str[index]))
-			{
-				status = false;
-				result = "[0,\"Invalid SteamID\"";
-				break;
-			}
-		}
-	}
-
-	if (status)
-	{
-		Poco::Int64 steamID = Poco::NumberParser::parse64(input_str);
-		Poco::Int8 i = 0, parts[8] = { 0 };
-
-		do
-		{
-			parts[i++] = steamID & 0xFFu;
-		} while (steamID >>= 8);
-
-		std::stringstream bestring;
-		bestring << "BE";
-		for (auto &part: parts)
-		{
-			bestring << char(part);
-		}
-
-		std::lock_guard<std::mutex> lock(mutex_md5);
-		md5.update(bestring.str());
-		result = "[1,\"" + Poco::DigestEngine::digestToHex(md5.digest()) + "\"]";
+		result = "[0,\"Invalid SteamID\"]";
 	}
 }
 
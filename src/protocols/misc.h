@@ -20,11 +20,6 @@ along with this program. If not, see <http://www.gnu.org/licenses/>.
 
 #include <string>
 
-#include <boost/crc.hpp>
-
-#include <Poco/MD4Engine.h>
-#include <Poco/MD5Engine.h>
-
 #include "abstract_protocol.h"
 
 
@@ -35,15 +30,6 @@ class MISC: public AbstractProtocol
 		bool callProtocol(std::string input_str, std::string &result, const bool async_method, const unsigned int unique_id=1);
 
 	private:
-		Poco::MD5Engine md5;
-		std::mutex mutex_md5;
-
-		Poco::MD4Engine md4;
-		std::mutex mutex_md4;
-
-		boost::crc_32_type crc32;
-		std::mutex mutex_crc32;
-
 		void getCrc32(std::string &input_str, std::string &result);
 		void getMD4(std::string &input_str, std::string &result);
 		void getMD5(std::string &input_str, std::string &result);
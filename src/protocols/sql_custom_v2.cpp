@@ -23,6 +23,7 @@ along with this program. If not, see <http://www.gnu.org/licenses/>.
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/erase.hpp>
+#include <boost/bind.hpp>
 #include <boost/filesystem.hpp>
 
 #include <Poco/Data/RecordSet.h>
@@ -39,17 +40,23 @@ along with this program. If not, see <http://www.gnu.org/licenses/>.
 #include <Poco/Util/AbstractConfiguration.h>
 #include <Poco/Util/IniFileConfiguration.h>
 
-#include <Poco/DigestEngine.h>
-#include <Poco/MD5Engine.h>
-
 #include <Poco/Exception.h>
 
+#include "../hash.h"
 #include "../sanitize.h"
+#include "../tokenizer.h"
 
 
 bool SQL_CUSTOM_V2::init(AbstractExt *extension, const std::string &database_id, const std::string &init_str)
 {
 	extension_ptr = extension;
+	statements_cache_hits = 0;
+	statements_cache_misses = 0;
+	statements_cache_evictions = 0;
+	statements_cache_invalidations = 0;
+	result_cache_hits = 0;
+	result_cache_misses = 0;
+
 	if (extension_ptr->ext_connectors_info.databases.count(database_id) == 0)
 	{
 		#ifdef DEBUG_TESTING
@@ -155,14 +162,31 @@ bool SQL_CUSTOM_V2::init(AbstractExt *extension, const std::string &database_id,
 		if ((template_ini->getInt("Default.Version", 1)) >= EXTDB_SQL_CUSTOM_V2_REQUIRED_VERSION)
 		{
 			default_seperator = char(template_ini->getInt("Default.Seperator Character (Base10)", 58));
+			default_batch_seperator = char(template_ini->getInt("Default.Batch Seperator Character (Base10)", 124));
 			int default_number_of_inputs = template_ini->getInt("Default.Number of Inputs", 0);
 			int default_number_of_custom_inputs = template_ini->getInt("Default.Number of Custom Inputs", 0);
 
 			bool default_input_sanitize_value_check = template_ini->getBool("Default.Sanitize Input Value Check", true);
 			bool default_output_sanitize_value_check = template_ini->getBool("Default.Sanitize Output Value Check", true);
 			bool default_preparedStatement_cache = template_ini->getBool("Default.Prepared Statement Cache", true);
+			statements_cache_size = template_ini->getInt("Default.Prepared Statement Cache Size", 100);
+			custom_statements_cache_size = template_ini->getInt("Default.Prepared Statement Custom Cache Size", 20);
 			bool default_returnInsertID = template_ini->getBool("Default.Return InsertID", false);
 			bool default_returnPlayerKey = template_ini->getBool("Default.Return PlayerKey", false);
+			bool default_bulk = template_ini->getBool("Default.Bulk", false);
+			bool default_read_only = template_ini->getBool("Default.Read Only", false);
+			bool default_transaction = template_ini->getBool("Default.Transaction", false);
+
+			bool default_write_behind = template_ini->getBool("Default.Write Behind", false);
+			int default_write_behind_key = template_ini->getInt("Default.Write Behind Key", 1);
+			int default_write_behind_interval = template_ini->getInt("Default.Write Behind Interval", 1000);
+			int default_write_behind_max_queue = template_ini->getInt("Default.Write Behind Max Queue", 100);
+
+			int default_cache_ttl = template_ini->getInt("Default.Cache TTL", 0);
+			int default_cache_max_entries = template_ini->getInt("Default.Cache Max Entries", 1024);
+
+
+			int default_output_format = getOutputFormat(template_ini->getString("Default.Output Format", "SQF"), "Default");
 
 
 			bool default_strip = template_ini->getBool("Default.Strip", false);
@@ -211,11 +235,77 @@ bool SQL_CUSTOM_V2::init(AbstractExt *extension, const std::string &database_id,
 				{
 					custom_calls[call_name].seperator = default_seperator;
 				}
+				if (template_ini->hasOption(call_name + ".Batch Seperator Character (Base10)"))
+				{
+					custom_calls[call_name].batch_seperator = char(template_ini->getInt(call_name + ".Batch Seperator Character (Base10)"));
+				}
+				else
+				{
+					custom_calls[call_name].batch_seperator = default_batch_seperator;
+				}
 				custom_calls[call_name].number_of_inputs = template_ini->getInt(call_name + ".Number of Inputs", default_number_of_inputs);
 				custom_calls[call_name].number_of_custom_inputs = template_ini->getInt(call_name + ".Number of Custom Inputs", default_number_of_custom_inputs);
 				custom_calls[call_name].preparedStatement_cache = template_ini->getBool(call_name + ".Prepared Statement Cache", default_preparedStatement_cache);
 				custom_calls[call_name].returnInsertID = template_ini->getBool(call_name + ".Return InsertID", default_returnInsertID);
 				custom_calls[call_name].returnPlayerKey = template_ini->getBool(call_name + ".Return PlayerKey", default_returnPlayerKey);
+				custom_calls[call_name].bulk = template_ini->getBool(call_name + ".Bulk", default_bulk);
+				custom_calls[call_name].read_only = template_ini->getBool(call_name + ".Read Only", default_read_only);
+				custom_calls[call_name].transaction = template_ini->getBool(call_name + ".Transaction", default_transaction);
+				custom_calls[call_name].output_format = default_output_format;
+				if (template_ini->hasOption(call_name + ".Output Format"))
+				{
+					custom_calls[call_name].output_format = getOutputFormat(template_ini->getString(call_name + ".Output Format"), call_name);
+				}
+
+				custom_calls[call_name].write_behind = template_ini->getBool(call_name + ".Write Behind", default_write_behind);
+				custom_calls[call_name].write_behind_key = template_ini->getInt(call_name + ".Write Behind Key", default_write_behind_key);
+				custom_calls[call_name].write_behind_interval = template_ini->getInt(call_name + ".Write Behind Interval", default_write_behind_interval);
+				const int write_behind_max_queue = template_ini->getInt(call_name + ".Write Behind Max Queue", default_write_behind_max_queue);
+				custom_calls[call_name].write_behind_max_queue = std::max(write_behind_max_queue, 1);
+				if (custom_calls[call_name].write_behind)
+				{
+					if ((custom_calls[call_name].write_behind_key > custom_calls[call_name].number_of_inputs) || (write_behind_max_queue <= 0))
+					{
+						// Key past the last Input would queue every Call under one empty Key
+						status = false;
+						#ifdef DEBUG_TESTING
+							extension_ptr->console->warn("extDB2: SQL_CUSTOM_V2: Invalid Write Behind Key (<= Number of Inputs) or Max Queue (> 0): {0}", call_name);
+						#endif
+						extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Invalid Write Behind Key (<= Number of Inputs) or Max Queue (> 0): {0}", call_name);
+					}
+					else if (custom_calls[call_name].number_of_custom_inputs > 0)
+					{
+						custom_calls[call_name].write_behind = false;
+						#ifdef DEBUG_TESTING
+							extension_ptr->console->warn("extDB2: SQL_CUSTOM_V2: Write Behind Not Supported with Custom Inputs: {0}", call_name);
+						#endif
+						extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Write Behind Not Supported with Custom Inputs: {0}", call_name);
+					}
+					else
+					{
+						write_behind_queues[call_name].reset(new writeBehindQueue());
+						write_behind_queues[call_name]->timer.reset(new boost::asio::deadline_timer(extension_ptr->getBulkIOService()));
+					}
+				}
+
+				// Result Cache (TTL in ms, 0 == Disabled)
+				int cache_ttl = template_ini->getInt(call_name + ".Cache TTL", default_cache_ttl);
+				if (cache_ttl > 0)
+				{
+					if (custom_calls[call_name].returnInsertID || custom_calls[call_name].returnPlayerKey)
+					{
+						#ifdef DEBUG_TESTING
+							extension_ptr->console->warn("extDB2: SQL_CUSTOM_V2: Cache TTL Not Supported with Return InsertID / PlayerKey: {0}", call_name);
+						#endif
+						extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Cache TTL Not Supported with Return InsertID / PlayerKey: {0}", call_name);
+					}
+					else
+					{
+						custom_calls[call_name].result_cache = std::make_shared<Poco::ExpireLRUCache<std::string, std::string> >(template_ini->getInt(call_name + ".Cache Max Entries", default_cache_max_entries), cache_ttl);
+					}
+				}
+				Poco::StringTokenizer tokens_cache_invalidate(template_ini->getString(call_name + ".Cache Invalidate", ""), ",", Poco::StringTokenizer::TOK_TRIM | Poco::StringTokenizer::TOK_IGNORE_EMPTY);
+				custom_calls[call_name].cache_invalidate_calls.assign(tokens_cache_invalidate.begin(), tokens_cache_invalidate.end());
 
 				if (template_ini->has(call_name + ".Strip Chars Action"))
 				{
@@ -453,41 +543,109 @@ bool SQL_CUSTOM_V2::init(AbstractExt *extension, const std::string &database_id,
 
 
 void SQL_CUSTOM_V2::getBEGUID(std::string &input_str, std::string &result)
-// From Frank https://gist.github.com/Fank/11127158
-// Modified to use lib poco
+// Lock-Free, called per Row / Value
 {
-	if (input_str.empty())
+	if (!(Hash::getBEGUID(input_str, result)))
 	{
 		result = "Invalid SteamID";
 	}
-	else
+}
+
+
+bool SQL_CUSTOM_V2::isIntegerColumn(const Poco::Data::MetaColumn::ColumnDataType &column_type)
+{
+	switch (column_type)
 	{
-		Poco::Int64 steamID;
-		if (Poco::NumberParser::tryParse64(input_str, steamID))
-		{
-			Poco::Int8 i = 0;
-			Poco::Int8 parts[8] = { 0 };
+		case Poco::Data::MetaColumn::FDT_INT8:
+		case Poco::Data::MetaColumn::FDT_UINT8:
+		case Poco::Data::MetaColumn::FDT_INT16:
+		case Poco::Data::MetaColumn::FDT_UINT16:
+		case Poco::Data::MetaColumn::FDT_INT32:
+		case Poco::Data::MetaColumn::FDT_UINT32:
+		case Poco::Data::MetaColumn::FDT_INT64:
+		case Poco::Data::MetaColumn::FDT_UINT64:
+			return true;
+		default:
+			return false;
+	}
+}
 
-			do
-			{
-				parts[i++] = steamID & 0xFFu;
-			} while (steamID >>= 8);
 
-			std::stringstream bestring;
-			bestring << "BE";
-			for (auto &part: parts)
-			{
-				bestring << char(part);
-			}
+int SQL_CUSTOM_V2::getOutputFormat(const std::string &output_format_str, const std::string &call_name)
+// 0 == SQF, 1 == Simple Array, 2 == Columnar
+{
+	if (boost::algorithm::iequals(output_format_str, std::string("SQF")) == 1)
+	{
+		return 0;
+	}
+	else if (boost::algorithm::iequals(output_format_str, std::string("Simple Array")) == 1)
+	{
+		return 1;
+	}
+	else if (boost::algorithm::iequals(output_format_str, std::string("Columnar")) == 1)
+	{
+		return 2;
+	}
+	#ifdef DEBUG_TESTING
+		extension_ptr->console->warn("extDB2: SQL_CUSTOM_V2: Invalid Output Format: {0} for {1}, using SQF", output_format_str, call_name);
+	#endif
+	extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Invalid Output Format: {0} for {1}, using SQF", output_format_str, call_name);
+	return 0;
+}
 
-			std::lock_guard<std::mutex> lock(mutex_md5);
-			md5.update(bestring.str());
-			result = Poco::DigestEngine::digestToHex(md5.digest());
-		}
-		else
-		{
-			result = "Invalid SteamID";
-		}
+
+bool SQL_CUSTOM_V2::isNumberColumn(const Poco::Data::MetaColumn::ColumnDataType &column_type)
+{
+	return (isIntegerColumn(column_type) || (column_type == Poco::Data::MetaColumn::FDT_FLOAT) || (column_type == Poco::Data::MetaColumn::FDT_DOUBLE));
+}
+
+
+void SQL_CUSTOM_V2::getValue(Poco::Data::RecordSet &rs, const Poco::Data::MetaColumn::ColumnDataType &column_type, const std::size_t &col, const std::size_t &row, std::string &value)
+// Reads Value via its native Column Type straight into value (reuses its capacity)
+//   Only uncommon types (Date / Time / Blob etc) are converted via Poco::Dynamic::Var
+{
+	value.clear();
+	if (rs.isNull(col, row))
+	{
+		return;
+	}
+	switch (column_type)
+	{
+		case Poco::Data::MetaColumn::FDT_INT8:
+			Poco::NumberFormatter::append(value, static_cast<int>(rs.value<Poco::Int8>(col, row)));
+			break;
+		case Poco::Data::MetaColumn::FDT_UINT8:
+			Poco::NumberFormatter::append(value, static_cast<unsigned int>(rs.value<Poco::UInt8>(col, row)));
+			break;
+		case Poco::Data::MetaColumn::FDT_INT16:
+			Poco::NumberFormatter::append(value, static_cast<int>(rs.value<Poco::Int16>(col, row)));
+			break;
+		case Poco::Data::MetaColumn::FDT_UINT16:
+			Poco::NumberFormatter::append(value, static_cast<unsigned int>(rs.value<Poco::UInt16>(col, row)));
+			break;
+		case Poco::Data::MetaColumn::FDT_INT32:
+			Poco::NumberFormatter::append(value, rs.value<Poco::Int32>(col, row));
+			break;
+		case Poco::Data::MetaColumn::FDT_UINT32:
+			Poco::NumberFormatter::append(value, rs.value<Poco::UInt32>(col, row));
+			break;
+		case Poco::Data::MetaColumn::FDT_INT64:
+			Poco::NumberFormatter::append(value, rs.value<Poco::Int64>(col, row));
+			break;
+		case Poco::Data::MetaColumn::FDT_UINT64:
+			Poco::NumberFormatter::append(value, rs.value<Poco::UInt64>(col, row));
+			break;
+		case Poco::Data::MetaColumn::FDT_FLOAT:
+			Poco::NumberFormatter::append(value, rs.value<float>(col, row));
+			break;
+		case Poco::Data::MetaColumn::FDT_DOUBLE:
+			Poco::NumberFormatter::append(value, rs.value<double>(col, row));
+			break;
+		case Poco::Data::MetaColumn::FDT_STRING:
+			value = rs.value<std::string>(col, row);
+			break;
+		default:
+			value = rs.value(col, row).convert<std::string>();
 	}
 }
 
@@ -512,9 +670,11 @@ void SQL_CUSTOM_V2::getResult(Custom_Call_UnorderedMap::const_iterator &custom_c
 		Poco::Data::RecordSet rs(sql_statement);
 
 		std::size_t cols = rs.columnCount();
-		if (cols >= 1)
+		std::size_t rows = rs.rowCount();
+		if ((cols >= 1) && (rows >= 1))
 		{
-			std::size_t sql_output_options_size = custom_calls_itr->second.sql_outputs_options.size();
+			const std::vector<Value_Options> &sql_outputs_options = custom_calls_itr->second.sql_outputs_options;
+			std::size_t sql_output_options_size = sql_outputs_options.size();
 			#ifdef DEBUG_LOGGING
 				if (cols != sql_output_options_size)
 				{
@@ -525,150 +685,200 @@ void SQL_CUSTOM_V2::getResult(Custom_Call_UnorderedMap::const_iterator &custom_c
 				}
 			#endif
 
+			std::vector<Poco::Data::MetaColumn::ColumnDataType> column_types;
+			column_types.reserve(cols);
+			for (std::size_t col = 0; col < cols; ++col)
+			{
+				column_types.push_back(rs.columnType(col));
+			}
+
 			std::string temp_str;
-			temp_str.reserve(result.capacity());
+			std::string typed_str;
+
+			// Output Format
+			//   SQF:          [[row1 col1,row1 col2],[row2 col1,...]], values without OUTPUT Options are returned as is
+			//   Simple Array: same layout, values without OUTPUT Options are typed (numbers as is, else quoted + escaped) so parseSimpleArray can read the result
+			//   Columnar:     Simple Array values, [[row1 col1,row2 col1,...],[row1 col2,...]], one array per column instead of per row
+			const int output_format = custom_calls_itr->second.output_format;
+			std::vector<std::string> columns_results;
+			if (output_format == 2)
+			{
+				columns_results.resize(cols);
+			}
 
-			bool more = rs.moveFirst();
-			if (more)
+			for (std::size_t row = 0; ((row < rows) && sanitize_value_check); ++row)
 			{
-				result += "[";
-				while (more)
+				if (row == 1)
 				{
-					for (std::size_t col = 0; col < cols; ++col)
+					// Pre-size Result from size of first row, saves reallocating on large results
+					if (output_format == 2)
 					{
-						if (rs[col].isEmpty())
+						for (auto &column_result : columns_results)
 						{
-							temp_str.clear();
-						}
-						else
-						{
-							temp_str = rs[col].convert<std::string>();
+							column_result.reserve(column_result.size() * rows);
 						}
+					}
+					else
+					{
+						result.reserve(result.size() + (result.size() * rows));
+					}
+				}
+				if (output_format != 2)
+				{
+					result += (row == 0) ? "[" : ",[";
+				}
+				for (std::size_t col = 0; col < cols; ++col)
+				{
+					getValue(rs, column_types[col], col, row, temp_str);
 
-						// NO OUTPUT OPTIONS
-						if (col >= sql_output_options_size)
+					// NO OUTPUT OPTIONS
+					if (col >= sql_output_options_size)
+					{
+						if (output_format == 0)
 						{
 							// DEFAULT BEHAVIOUR
 							if (temp_str.empty())
 							{
-								result += "\"\"";
+								temp_str = "\"\"";
+							}
+						}
+						else if (temp_str.empty() || !(isNumberColumn(column_types[col])))
+						{
+							// TYPED, NULL == ""
+							typed_str.clear();
+							Sqf::appendString(typed_str, temp_str);
+							temp_str.swap(typed_str);
+						}
+					}
+					else
+					{
+						// STEAM ID + QUERYS
+						if (sql_outputs_options[col].vac_steamID)
+						{
+							// QUERY STEAM
+							extension_ptr->steamQuery(-1, false, true, temp_str, true);
+						}
+						if (sql_outputs_options[col].beguid)
+						{
+							// GENERATE BEGUID
+							getBEGUID(temp_str, temp_str);
+						}
+						// STRING
+						if (sql_outputs_options[col].string)
+						{
+							if (temp_str.empty())
+							{
+								temp_str = "\"\"";
 							}
 							else
 							{
-								result += temp_str;
+								boost::erase_all(temp_str, "\"");
+								boost::erase_all(temp_str, "'");
+								temp_str = "\"" + temp_str + "\"";
 							}
 						}
-						else
+						else if (sql_outputs_options[col].string_escape_quotes)
 						{
-							// STEAM ID + QUERYS
-							if (custom_calls_itr->second.sql_outputs_options[col].vac_steamID)
+							if (temp_str.empty())
 							{
-								// QUERY STEAM
-								extension_ptr->steamQuery(-1, false, true, temp_str, true);
+								temp_str = "\"\"";
 							}
-							if (custom_calls_itr->second.sql_outputs_options[col].beguid)
+							else
 							{
-								// GENERATE BEGUID
-								getBEGUID(temp_str, temp_str);
+								boost::replace_all(temp_str, "\"", "\"\"");
+								boost::replace_all(temp_str, "'", "''");
+								temp_str = "\"" + temp_str + "\"";
 							}
-							// STRING
-							if (custom_calls_itr->second.sql_outputs_options[col].string)
+						}
+						// DateTime_ISO8601
+						else if (sql_outputs_options[col].datetime_iso8601)
+						{
+							if (temp_str.empty())
 							{
-								if (temp_str.empty())
-								{
-									temp_str = "\"\"";
-								}
-								else
-								{
-									boost::erase_all(temp_str, "\"");
-									boost::erase_all(temp_str, "'");
-									temp_str = "\"" + temp_str + "\"";
-								}
+								temp_str = "[]";
 							}
-							else if (custom_calls_itr->second.sql_outputs_options[col].string_escape_quotes)
+							else
 							{
-								if (temp_str.empty())
+								Poco::DateTime dt;
+								if ((column_types[col] == Poco::Data::MetaColumn::FDT_TIMESTAMP) && (!sql_outputs_options[col].beguid))
 								{
-									temp_str = "\"\"";
+									dt = rs.value<Poco::DateTime>(col, row);
 								}
 								else
 								{
-									boost::replace_all(temp_str, "\"", "\"\"");
-									boost::replace_all(temp_str, "'", "''");
-									temp_str = "\"" + temp_str + "\"";
+									int tzd = 0;
+									dt = Poco::DateTimeParser::parse(Poco::DateTimeFormat::ISO8601_FRAC_FORMAT, temp_str, tzd);
 								}
+								temp_str = "[" + Poco::NumberFormatter::format(dt.year()) + ","
+									+ Poco::NumberFormatter::format(dt.month()) + ","
+									+ Poco::NumberFormatter::format(dt.day()) + ","
+									+ Poco::NumberFormatter::format(dt.hour()) + ","
+									+ Poco::NumberFormatter::format(dt.minute()) + ","
+									+ Poco::NumberFormatter::format(dt.second()) + "]";
 							}
-							// DateTime_ISO8601
-							else if (custom_calls_itr->second.sql_outputs_options[col].datetime_iso8601)
+						}
+						// BOOL
+						else if (sql_outputs_options[col].boolean)
+						{
+							if (temp_str.empty())
 							{
-								if (temp_str.empty())
-								{
-									temp_str = "[]";
-								}
-								else
-								{
-									int tzd = 0;
-									Poco::DateTime dt = Poco::DateTimeParser::parse(Poco::DateTimeFormat::ISO8601_FRAC_FORMAT, temp_str, tzd);
-									temp_str = "[" + Poco::NumberFormatter::format(dt.year()) + ","
-										+ Poco::NumberFormatter::format(dt.month()) + ","
-										+ Poco::NumberFormatter::format(dt.day()) + ","
-										+ Poco::NumberFormatter::format(dt.hour()) + ","
-										+ Poco::NumberFormatter::format(dt.minute()) + ","
-										+ Poco::NumberFormatter::format(dt.second()) + "]";
-								}
+								temp_str = "false";
 							}
-							// BOOL
-							else if (custom_calls_itr->second.sql_outputs_options[col].boolean)
+							else if (isIntegerColumn(column_types[col]) && (temp_str != "0") && (temp_str[0] != '-'))
 							{
-								if (temp_str.empty())
-								{
-									temp_str = "false";
-								}
-								else if (rs[col].isInteger())
-								{
-									if (rs[col].convert<int>() > 0)
-									{
-										temp_str = "true";
-									}
-									else
-									{
-										temp_str = "false";
-									}
-								}
-								else
-								{
-									temp_str = "false";
-								}
+								temp_str = "true";
 							}
-							else if (temp_str.empty())
+							else
 							{
-								temp_str = "\"\"";
+								temp_str = "false";
 							}
-							// SANITIZE CHECK
-							if (custom_calls_itr->second.sql_outputs_options[col].check)
+						}
+						else if (temp_str.empty())
+						{
+							temp_str = "\"\"";
+						}
+						// SANITIZE CHECK
+						if (sql_outputs_options[col].check)
+						{
+							if (!(Sqf::check(temp_str)))
 							{
-								if (!(Sqf::check(temp_str)))
-								{
-									extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Sanitize Check Error: Value: {0}", temp_str);
-									sanitize_value_check = false;
-									break;
-								}
+								extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Sanitize Check Error: Value: {0}", temp_str);
+								sanitize_value_check = false;
+								break;
 							}
-							result += temp_str;
 						}
+					}
 
-						if (col < (cols - 1))
+					if (output_format == 2)
+					{
+						if (row > 0)
 						{
-							result += ",";
+							columns_results[col] += ",";
 						}
+						columns_results[col] += temp_str;
 					}
-					more = rs.moveNext();
-					if (more)
+					else
 					{
-						result += "],[";
+						if (col > 0)
+						{
+							result += ",";
+						}
+						result += temp_str;
 					}
 				}
-				result += "]";
+				if (output_format != 2)
+				{
+					result += "]";
+				}
+			}
+			if (output_format == 2)
+			{
+				for (std::size_t col = 0; col < cols; ++col)
+				{
+					result += (col == 0) ? "[" : ",[";
+					result += columns_results[col];
+					result += "]";
+				}
 			}
 		}
 		if (!(sanitize_value_check))
@@ -800,15 +1010,136 @@ void SQL_CUSTOM_V2::executeSQL(Poco::Data::Statement &sql_statement, std::string
 }
 
 
+SQL_CUSTOM_V2::sessionStatements &SQL_CUSTOM_V2::getSessionStatements_mutexlock(Poco::Data::SessionPool::SessionDataPtr &session_data_ptr)
+// Gets Statements LRU for Session
+//   Sessions dropped by the SessionPool are only referenced from here, so they get pruned when a new Session shows up
+{
+	std::lock_guard<std::mutex> lock(mutex_sessions_statements);
+	auto itr = sessions_statements.find(session_data_ptr.get());
+	if (itr == sessions_statements.end())
+	{
+		for (auto prune_itr = sessions_statements.begin(); prune_itr != sessions_statements.end();)
+		{
+			if (prune_itr->second.session_data_ptr.referenceCount() == 1)
+			{
+				prune_itr = sessions_statements.erase(prune_itr);
+			}
+			else
+			{
+				++prune_itr;
+			}
+		}
+		itr = sessions_statements.emplace(session_data_ptr.get(), sessionStatements()).first;
+		itr->second.session_data_ptr = session_data_ptr;
+	}
+	return itr->second; // Only Thread using the Session touches its entry, references stay valid on rehash
+}
+
+
+void SQL_CUSTOM_V2::cacheStatement(Poco::Data::SessionPool::SessionDataPtr &session_data_ptr, statementsLRU &statements_lru, const std::size_t &max_size, const std::string &sql_str)
+// Marks Statement as most recently used, evicts least recently used Statement when over max_size
+{
+	auto itr = statements_lru.sql_strs_itrs.find(sql_str);
+	if (itr != statements_lru.sql_strs_itrs.end())
+	{
+		statements_lru.sql_strs.splice(statements_lru.sql_strs.begin(), statements_lru.sql_strs, itr->second);
+	}
+	else
+	{
+		statements_lru.sql_strs.push_front(sql_str);
+		statements_lru.sql_strs_itrs[sql_str] = statements_lru.sql_strs.begin();
+		while (statements_lru.sql_strs.size() > max_size)
+		{
+			session_data_ptr->statements_map.erase(statements_lru.sql_strs.back());
+			statements_lru.sql_strs_itrs.erase(statements_lru.sql_strs.back());
+			statements_lru.sql_strs.pop_back();
+			++statements_cache_evictions;
+		}
+	}
+}
+
+
+void SQL_CUSTOM_V2::invalidateStatement(Poco::Data::SessionPool::SessionDataPtr &session_data_ptr, statementsLRU &statements_lru, const std::string &sql_str)
+// Removes single Statement from Session Cache
+{
+	if (session_data_ptr->statements_map.erase(sql_str) > 0)
+	{
+		++statements_cache_invalidations;
+	}
+	auto itr = statements_lru.sql_strs_itrs.find(sql_str);
+	if (itr != statements_lru.sql_strs_itrs.end())
+	{
+		statements_lru.sql_strs.erase(itr->second);
+		statements_lru.sql_strs_itrs.erase(itr);
+	}
+}
+
+
+bool SQL_CUSTOM_V2::isBulkCall(const boost::string_ref &input_str)
+// Bulk Worker Lane, if Protocol is Bulk or Custom Call has Bulk = true (BATCH uses the Custom Call it batches)
+{
+	if (bulk)
+	{
+		return true;
+	}
+	boost::string_ref callname = input_str.substr(0, input_str.find(default_seperator[0]));
+	auto custom_calls_const_itr = custom_calls.find(callname.to_string());
+	if ((custom_calls_const_itr == custom_calls.end()) && (callname == "BATCH") && (callname.size() < input_str.size()))
+	{
+		const boost::string_ref batch_str = input_str.substr(callname.size() + 1);
+		custom_calls_const_itr = custom_calls.find(batch_str.substr(0, batch_str.find(default_seperator[0])).to_string());
+	}
+	return ((custom_calls_const_itr != custom_calls.end()) && custom_calls_const_itr->second.bulk);
+}
+
+
+void SQL_CUSTOM_V2::getStats(std::string &result)
+{
+	result = "[1,[[\"CACHE HITS\"," + Poco::NumberFormatter::format(statements_cache_hits.load()) + "],"
+		+ "[\"CACHE MISSES\"," + Poco::NumberFormatter::format(statements_cache_misses.load()) + "],"
+		+ "[\"CACHE EVICTIONS\"," + Poco::NumberFormatter::format(statements_cache_evictions.load()) + "],"
+		+ "[\"CACHE INVALIDATIONS\"," + Poco::NumberFormatter::format(statements_cache_invalidations.load()) + "],"
+		+ "[\"RESULT CACHE HITS\"," + Poco::NumberFormatter::format(result_cache_hits.load()) + "],"
+		+ "[\"RESULT CACHE MISSES\"," + Poco::NumberFormatter::format(result_cache_misses.load()) + "]]]";
+}
+
+
 void SQL_CUSTOM_V2::callPreparedStatement(std::string call_name, Custom_Call_UnorderedMap::const_iterator custom_calls_itr, std::vector< std::vector<std::string> > &all_processed_inputs, std::vector<std::string> &custom_inputs, std::string &player_key, bool &status, std::string &result)
 {
 	Poco::Data::SessionPool::SessionDataPtr session_data_ptr;
+	sessionStatements *session_statements_ptr = nullptr;
+	statementsLRU *statements_lru_ptr = nullptr;
+	std::vector<std::string> sql_strs_used;
+	std::unique_ptr<Poco::Data::Session> session_ptr; // Kept outside try, so Exceptions can rollback the Transaction
 	try
 	{
-		Poco::Data::Session session = extension_ptr->getDBSession_mutexlock(*database_ptr, session_data_ptr);
+		AbstractExt::DBConnectionInfo &database = custom_calls_itr->second.read_only ? extension_ptr->getReadDBConnection(*database_ptr) : *database_ptr;
+		Poco::Data::Session session = extension_ptr->getDBSession_mutexlock(database, session_data_ptr);
+		session_ptr.reset(new Poco::Data::Session(session));
+		session_statements_ptr = &getSessionStatements_mutexlock(session_data_ptr);
+
+		statements_lru_ptr = &session_statements_ptr->statements;
+		std::size_t statements_lru_max_size = statements_cache_size;
+		if (!custom_inputs.empty())
+		{
+			statements_lru_ptr = &session_statements_ptr->custom_statements;
+			statements_lru_max_size = custom_statements_cache_size;
+		}
 
 		std::string sql_str;
 
+		// Transaction, all SQL Statements commit together (one commit instead of one per Statement)
+		const bool transaction = custom_calls_itr->second.transaction;
+		if (session.isTransaction())
+		{
+			// Sticky Sessions, Transaction left open by an earlier Exception
+			session.rollback();
+		}
+		if (transaction)
+		{
+			session.begin();
+		}
+
 		int i = -1;
 		for (std::vector< std::string >::const_iterator it_sql_prepared_statements_vector = custom_calls_itr->second.sql_prepared_statements.begin(); it_sql_prepared_statements_vector != custom_calls_itr->second.sql_prepared_statements.end(); ++it_sql_prepared_statements_vector)
 		{
@@ -821,6 +1152,17 @@ void SQL_CUSTOM_V2::callPreparedStatement(std::string call_name, Custom_Call_Uno
 				++x;
 				boost::replace_all(sql_str, ("$CUSTOM_" + Poco::NumberFormatter::format(x) + "$"), replace_str);
 			}
+
+			if (session_data_ptr->statements_map.count(sql_str) > 0)
+			{
+				++statements_cache_hits;
+			}
+			else
+			{
+				++statements_cache_misses;
+			}
+			sql_strs_used.push_back(sql_str);
+
 			sql_statement << sql_str;
 
 			for (auto &processed_input : all_processed_inputs[i])
@@ -833,31 +1175,61 @@ void SQL_CUSTOM_V2::callPreparedStatement(std::string call_name, Custom_Call_Uno
 			{
 				break;
 			}
-			else if (it_sql_prepared_statements_vector + 1 == custom_calls_itr->second.sql_prepared_statements.end())
+			else
 			{
-				getResult(custom_calls_itr, session, sql_statement, player_key, result, status);
-				if (!status)
+				if (custom_calls_itr->second.preparedStatement_cache)
 				{
-					break;
+					cacheStatement(session_data_ptr, *statements_lru_ptr, statements_lru_max_size, sql_str);
+				}
+				else
+				{
+					session_data_ptr->statements_map.erase(sql_str);
+				}
+				if (it_sql_prepared_statements_vector + 1 == custom_calls_itr->second.sql_prepared_statements.end())
+				{
+					getResult(custom_calls_itr, session, sql_statement, player_key, result, status);
+					if (!status)
+					{
+						break;
+					}
 				}
 			}
 		}
+		if (transaction)
+		{
+			if (status)
+			{
+				session.commit();
+			}
+			else
+			{
+				#ifdef DEBUG_TESTING
+					extension_ptr->console->error("extDB2: SQL_CUSTOM_V2: Transaction Rollback for Call: {0}", call_name);
+				#endif
+				extension_ptr->logger->error("extDB2: SQL_CUSTOM_V2: Transaction Rollback for Call: {0}", call_name);
+				session.rollback();
+			}
+		}
 		if (!status)
 		{
-			// Don't need to wipe cached session if error caused by sanitize check
+			// Don't need to invalidate cached statements if error caused by sanitize check
 			if (result != "[0,\"Error Value Failed Sanitize Check\"]")
 			{
 				#ifdef DEBUG_TESTING
-					extension_ptr->console->error("extDB2: SQL_CUSTOM_V2: Wiping Statements + Session");
+					extension_ptr->console->error("extDB2: SQL_CUSTOM_V2: Invalidating Cached Statements for Call: {0}", call_name);
 				#endif
-				extension_ptr->logger->error("extDB2: SQL_CUSTOM_V2: Wiping Statements + Session");
-				session_data_ptr->statements_map.clear();
+				extension_ptr->logger->error("extDB2: SQL_CUSTOM_V2: Invalidating Cached Statements for Call: {0}", call_name);
+				for (auto &sql_str_used : sql_strs_used)
+				{
+					invalidateStatement(session_data_ptr, *statements_lru_ptr, sql_str_used);
+				}
 			}
 		}
 	}
 	catch (Poco::Data::MySQL::ConnectionException& e)
 	{
 		status = false;
+		rollbackSession(session_ptr);
 		#ifdef DEBUG_TESTING
 			extension_ptr->console->error("extDB2: SQL_CUSTOM_V2: Error ConnectionException: {0}", e.displayText());
 		#endif
@@ -865,12 +1237,20 @@ void SQL_CUSTOM_V2::callPreparedStatement(std::string call_name, Custom_Call_Uno
 		result = "[0,\"Error Connection Exception\"]";
 		if (!session_data_ptr.isNull())
 		{
+			// Connection Lost, every Statement for this Session is invalid
+			statements_cache_invalidations += session_data_ptr->statements_map.size();
  			session_data_ptr->statements_map.clear();
+			if (session_statements_ptr != nullptr)
+			{
+				session_statements_ptr->statements = statementsLRU();
+				session_statements_ptr->custom_statements = statementsLRU();
+			}
 		}
 	}
 	catch (Poco::Data::ConnectionFailedException& e)
 	{
 		status = false;
+		rollbackSession(session_ptr);
 		#ifdef DEBUG_TESTING
 			extension_ptr->console->error("extDB2: SQL_CUSTOM_V2: Error ConnectionFailedException: {0}", e.displayText());
 		#endif
@@ -878,47 +1258,381 @@ void SQL_CUSTOM_V2::callPreparedStatement(std::string call_name, Custom_Call_Uno
 		result = "[0,\"Error ConnectionFailedException\"]";
 		if (!session_data_ptr.isNull())
 		{
+			// Connection Lost, every Statement for this Session is invalid
+			statements_cache_invalidations += session_data_ptr->statements_map.size();
  			session_data_ptr->statements_map.clear();
+			if (session_statements_ptr != nullptr)
+			{
+				session_statements_ptr->statements = statementsLRU();
+				session_statements_ptr->custom_statements = statementsLRU();
+			}
 		}
 	}
 	catch (Poco::Exception& e)
 	{
 		status = false;
+		rollbackSession(session_ptr);
 		#ifdef DEBUG_TESTING
 			extension_ptr->console->error("extDB2: SQL_CUSTOM_V2: Error Exception: {0}", e.displayText());
 		#endif
 		extension_ptr->logger->error("extDB2: SQL_CUSTOM_V2: Error Exception: {0}", e.displayText());
 		result = "[0,\"Error Exception\"]";
-		if (!session_data_ptr.isNull())
+		if ((!session_data_ptr.isNull()) && (statements_lru_ptr != nullptr))
 		{
- 			session_data_ptr->statements_map.clear();
+			// Only invalidate Statements for this Call
+			for (auto &sql_str_used : sql_strs_used)
+			{
+				invalidateStatement(session_data_ptr, *statements_lru_ptr, sql_str_used);
+			}
 		}
 	}
 }
 
 
-bool SQL_CUSTOM_V2::callProtocol(std::string input_str, std::string &result, const bool async_method, const unsigned int unique_id)
+bool SQL_CUSTOM_V2::processInputs(Custom_Call_UnorderedMap::const_iterator custom_calls_itr, const std::string &input_str, const boost::string_ref &tokens_str, std::vector< std::vector<std::string> > &all_processed_inputs, std::vector<std::string> &custom_inputs, std::string &player_key, std::string &result)
+// Tokenizes Inputs + applies INPUT Options for each SQL Statement
 {
-	#ifdef DEBUG_TESTING
-		extension_ptr->console->info("extDB2: SQL_CUSTOM_V2: Trace: UniqueID: {0} Input: {1}", unique_id, input_str);
-	#endif
-	#ifdef DEBUG_LOGGING
-		extension_ptr->logger->info("extDB2: SQL_CUSTOM_V2: Trace: UniqueID: {0} Input: {1}", unique_id, input_str);
-	#endif
+	const int expected_inputs = (custom_calls_itr->second.number_of_inputs + custom_calls_itr->second.number_of_custom_inputs);
 
-	const std::string::size_type found = input_str.find(default_seperator);
-	std::string callname;
-	std::string tokens_str;
+	// Tokens point into input_str, only copied once Input Options are applied
+	std::vector<boost::string_ref> tokens;
+	Tokenizer::split(tokens_str, custom_calls_itr->second.seperator[0], tokens);
+	if (expected_inputs != tokens.size())
+	{
+		// BAD Number of Inputs
+		result = "[0,\"Error Incorrect Number of Inputs\"]";
+		extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Incorrect Number of Inputs: Input String {0}", input_str);
+		extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Incorrect Number of Inputs: Expected: {0} Got: {1}", expected_inputs, tokens.size());
+		#ifdef DEBUG_TESTING
+			extension_ptr->console->warn("extDB2: SQL_CUSTOM_V2: Incorrect Number of Inputs: Input String {0}", input_str);
+			extension_ptr->console->warn("extDB2: SQL_CUSTOM_V2: Incorrect Number of Inputs: Expected: {0} Got: {1}", expected_inputs, tokens.size());
+		#endif
+		return false;
+	}
 
-	if (found != std::string::npos)
+	// GOOD Number of Inputs
+	bool status = true;
+
+	const std::vector<boost::string_ref> &inputs = tokens; // Custom Inputs are after Inputs, never indexed via inputs
+
+	if (custom_calls_itr->second.number_of_custom_inputs > 0)
 	{
-		callname = input_str.substr(0, found);
-		tokens_str = input_str.substr(found+1);
+		custom_inputs.reserve(custom_calls_itr->second.number_of_custom_inputs);
+		for (std::size_t i = custom_calls_itr->second.number_of_inputs; i < tokens.size(); ++i)
+		{
+			custom_inputs.push_back(tokens[i].to_string());
+		}
+
+		for (auto &custom_input : custom_inputs)
+		{
+			for (auto &strip_char : custom_calls_itr->second.strip_custom_input_chars)
+			{
+				boost::erase_all(custom_input, std::string(1, strip_char));
+			}
+		}
 	}
-	else
+
+	// Multiple INPUT Lines
+	all_processed_inputs.reserve(custom_calls_itr->second.sql_inputs_options.size());
+
+	std::string sanitize_str;
+
+	for(auto &sql_inputs_options : custom_calls_itr->second.sql_inputs_options)
+	{
+		std::vector< std::string > processed_inputs;
+		for(auto &sql_input_option : sql_inputs_options)
+		{
+			std::string temp_str = inputs[sql_input_option.number].to_string();
+			// INPUT Options
+
+			// Strip
+			if (sql_input_option.strip)
+			{
+				for (auto &strip_char : custom_calls_itr->second.strip_chars)
+				{
+					boost::erase_all(temp_str, std::string(1, strip_char));
+				}
+				if (inputs[sql_input_option.number] != boost::string_ref(temp_str))
+				{
+					switch (custom_calls_itr->second.strip_chars_action)
+					{
+						case 3: // Strip + Log + Error
+							status = false;
+						case 2: // Strip + Log
+							extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Error Bad Char Detected: Input: {0}", input_str);
+							extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Error Bad Char Detected: Token: {0}", (sql_input_option.number));
+						case 1: // Strip
+							result = "[0,\"Error Strip Char Found\"]";
+							break;
+					}
+				}
+			}
+
+			// STEAM ID + QUERYS
+			if (sql_input_option.vac_steamID)
+			{
+				// QUERY STEAM
+				extension_ptr->steamQuery(-1, false, true, temp_str, true);
+			}
+			if (sql_input_option.beguid)
+			{
+				// GENERATE BEGUID
+				getBEGUID(temp_str, temp_str);
+				if (sql_input_option.return_player_key)
+				{
+					extension_ptr->getPlayerKey_BEGuid(temp_str, player_key);
+				}
+			}
+			else if (sql_input_option.return_player_key)
+			{
+				extension_ptr->getPlayerKey_SteamID(temp_str, player_key);
+			}
+
+
+			// STRING
+			if (sql_input_option.string)
+			{
+				if (temp_str.empty())
+				{
+					temp_str = "\"\"";
+				}
+				else
+				{
+					boost::erase_all(temp_str, "\"");
+					boost::erase_all(temp_str, "'");
+					temp_str = "\"" + temp_str + "\"";
+				}
+			}
+			else if (sql_input_option.string_escape_quotes)
+			{
+				if (temp_str.empty())
+				{
+					temp_str = "\"\"";
+				}
+				else
+				{
+					boost::replace_all(temp_str, "\"", "\"\"");
+					boost::replace_all(temp_str, "'", "''");
+					temp_str = "\"" + temp_str + "\"";
+				}
+			}
+			// BOOL
+			else if (sql_input_option.boolean)
+			{
+				if (boost::algorithm::iequals(temp_str, std::string("True")) == 1)
+				{
+					temp_str = "1";
+				}
+				else
+				{
+					temp_str = "0";
+				}
+			}
+
+			// SANITIZE CHECK
+			if (sql_input_option.check)
+			{
+				sanitize_str = temp_str;
+				if (sql_input_option.check_add_quotes)
+				{
+					sanitize_str = "\"" + sanitize_str + "\"";
+				}
+				else if (sql_input_option.check_add_escape_quotes)
+				{
+					boost::replace_all(temp_str, "\"", "\"\"");
+					boost::replace_all(temp_str, "'", "''");
+					sanitize_str = "\"" + temp_str + "\"";
+				}
+
+				if (!(Sqf::check(sanitize_str)))
+				{
+					status = false;
+					extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Sanitize Check Error: Input: {0}", input_str);
+					extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Sanitize Check Error: Value: {0}", sanitize_str);
+					result = "[0,\"Error Input Value is not sanitized\"]";
+				}
+			}
+			processed_inputs.push_back(std::move(temp_str));
+		}
+		all_processed_inputs.push_back(std::move(processed_inputs));
+	}
+
+	return status;
+}
+
+
+void SQL_CUSTOM_V2::rollbackSession(std::unique_ptr<Poco::Data::Session> &session_ptr)
+// Rollback Transaction left open by an Exception
+//   Sticky Sessions stay on the Worker Thread (not returned to Session Pool), so nothing else would roll it back
+{
+	if (session_ptr)
+	{
+		try
+		{
+			if (session_ptr->isTransaction())
+			{
+				session_ptr->rollback();
+			}
+		}
+		catch (Poco::Exception& e)
+		{
+			#ifdef DEBUG_TESTING
+				extension_ptr->console->error("extDB2: SQL_CUSTOM_V2: Error Rollback Exception: {0}", e.displayText());
+			#endif
+			extension_ptr->logger->error("extDB2: SQL_CUSTOM_V2: Error Rollback Exception: {0}", e.displayText());
+		}
+	}
+}
+
+
+void SQL_CUSTOM_V2::callBatchPreparedStatement(Custom_Call_UnorderedMap::const_iterator custom_calls_itr, std::vector< std::vector< std::vector<std::string> > > &rows_processed_inputs, bool &status, std::string &result)
+// Runs all Rows in one Transaction, each SQL Statement is prepared once + re-executed per Row
+{
+	Poco::Data::SessionPool::SessionDataPtr session_data_ptr;
+	std::unique_ptr<Poco::Data::Session> session_ptr; // Kept outside try, so Exceptions can rollback the Transaction
+	try
 	{
-		callname = input_str;
+		Poco::Data::Session session = extension_ptr->getDBSession_mutexlock(*database_ptr, session_data_ptr);
+		session_ptr.reset(new Poco::Data::Session(session));
+		sessionStatements &session_statements = getSessionStatements_mutexlock(session_data_ptr);
+
+		// Statements are bound by reference to bound_inputs, values are swapped in for each Row
+		std::vector< std::vector<std::string> > bound_inputs;
+		bound_inputs.reserve(custom_calls_itr->second.sql_inputs_options.size());
+		for (auto &sql_inputs_options : custom_calls_itr->second.sql_inputs_options)
+		{
+			bound_inputs.push_back(std::vector<std::string>(sql_inputs_options.size()));
+		}
+
+		std::vector<Poco::Data::Statement> sql_statements;
+		sql_statements.reserve(custom_calls_itr->second.sql_prepared_statements.size());
+		for (std::size_t i = 0; i < custom_calls_itr->second.sql_prepared_statements.size(); ++i)
+		{
+			const std::string &sql_str = custom_calls_itr->second.sql_prepared_statements[i];
+			if (session_data_ptr->statements_map.count(sql_str) > 0)
+			{
+				++statements_cache_hits;
+			}
+			else
+			{
+				++statements_cache_misses;
+			}
+			sql_statements.emplace_back(session);
+			sql_statements.back() << sql_str;
+			for (auto &bound_input : bound_inputs[i])
+			{
+				sql_statements.back(), Poco::Data::Keywords::use(bound_input);
+			}
+		}
+
+		if (session.isTransaction())
+		{
+			// Sticky Sessions, Transaction left open by an earlier Exception
+			session.rollback();
+		}
+		session.begin();
+		for (auto &row_processed_inputs : rows_processed_inputs)
+		{
+			for (std::size_t i = 0; i < sql_statements.size(); ++i)
+			{
+				// Swap each value, Statement is bound to the strings themselves (not the vector storage)
+				for (std::size_t j = 0; j < bound_inputs[i].size(); ++j)
+				{
+					bound_inputs[i][j].swap(row_processed_inputs[i][j]);
+				}
+				executeSQL(sql_statements[i], result, status);
+				for (std::size_t j = 0; j < bound_inputs[i].size(); ++j)
+				{
+					bound_inputs[i][j].swap(row_processed_inputs[i][j]);
+				}
+				if (!status)
+				{
+					break;
+				}
+			}
+			if (!status)
+			{
+				break;
+			}
+		}
+
+		if (status)
+		{
+			session.commit();
+			for (auto &sql_str : custom_calls_itr->second.sql_prepared_statements)
+			{
+				if (custom_calls_itr->second.preparedStatement_cache)
+				{
+					cacheStatement(session_data_ptr, session_statements.statements, statements_cache_size, sql_str);
+				}
+				else
+				{
+					session_data_ptr->statements_map.erase(sql_str);
+				}
+			}
+		}
+		else
+		{
+			#ifdef DEBUG_TESTING
+				extension_ptr->console->error("extDB2: SQL_CUSTOM_V2: Batch Rollback");
+			#endif
+			extension_ptr->logger->error("extDB2: SQL_CUSTOM_V2: Batch Rollback");
+			session.rollback();
+			for (auto &sql_str : custom_calls_itr->second.sql_prepared_statements)
+			{
+				invalidateStatement(session_data_ptr, session_statements.statements, sql_str);
+			}
+		}
+	}
+	catch (Poco::Data::MySQL::ConnectionException& e)
+	{
+		status = false;
+		rollbackSession(session_ptr);
+		#ifdef DEBUG_TESTING
+			extension_ptr->console->error("extDB2: SQL_CUSTOM_V2: Error ConnectionException: {0}", e.displayText());
+		#endif
+		extension_ptr->logger->error("extDB2: SQL_CUSTOM_V2: Error ConnectionException: {0}", e.displayText());
+		result = "[0,\"Error Connection Exception\"]";
+		if (!session_data_ptr.isNull())
+		{
+			statements_cache_invalidations += session_data_ptr->statements_map.size();
+			session_data_ptr->statements_map.clear();
+		}
+	}
+	catch (Poco::Data::ConnectionFailedException& e)
+	{
+		status = false;
+		rollbackSession(session_ptr);
+		#ifdef DEBUG_TESTING
+			extension_ptr->console->error("extDB2: SQL_CUSTOM_V2: Error ConnectionFailedException: {0}", e.displayText());
+		#endif
+		extension_ptr->logger->error("extDB2: SQL_CUSTOM_V2: Error ConnectionFailedException: {0}", e.displayText());
+		result = "[0,\"Error ConnectionFailedException\"]";
+		if (!session_data_ptr.isNull())
+		{
+			statements_cache_invalidations += session_data_ptr->statements_map.size();
+			session_data_ptr->statements_map.clear();
+		}
+	}
+	catch (Poco::Exception& e)
+	{
+		status = false;
+		rollbackSession(session_ptr);
+		#ifdef DEBUG_TESTING
+			extension_ptr->console->error("extDB2: SQL_CUSTOM_V2: Error Exception: {0}", e.displayText());
+		#endif
+		extension_ptr->logger->error("extDB2: SQL_CUSTOM_V2: Error Exception: {0}", e.displayText());
+		result = "[0,\"Error Exception\"]";
 	}
+}
+
+
+void SQL_CUSTOM_V2::callBatch(const std::string &input_str, const boost::string_ref &batch_str, std::string &result, const unsigned int unique_id)
+// BATCH:<callname>:<row1 inputs>|<row2 inputs>|...
+//   Returns [1,[<row1 status>,<row2 status>,...]], rows that fail INPUT checks are skipped
+{
+	const boost::string_ref::size_type found = batch_str.find(default_seperator[0]);
+	const std::string callname = batch_str.substr(0, found).to_string();
 
 	auto custom_calls_const_itr = custom_calls.find(callname);
 	if (custom_calls_const_itr == custom_calls.end())
@@ -932,197 +1646,315 @@ bool SQL_CUSTOM_V2::callProtocol(std::string input_str, std::string &result, con
 			extension_ptr->console->warn("extDB2: SQL_CUSTOM_V2: Error No Custom Call Not Found: Callname {0}", callname);
 		#endif
 	}
+	else if (custom_calls_const_itr->second.number_of_custom_inputs > 0)
+	{
+		// $CUSTOM_x$ changes SQL Statement per Row, can't be prepared once
+		result = "[0,\"Error Batch Not Supported with Custom Inputs\"]";
+		extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Error Batch Not Supported with Custom Inputs: Callname {0}", callname);
+		#ifdef DEBUG_TESTING
+			extension_ptr->console->warn("extDB2: SQL_CUSTOM_V2: Error Batch Not Supported with Custom Inputs: Callname {0}", callname);
+		#endif
+	}
 	else
 	{
-		const int expected_inputs = (custom_calls_const_itr->second.number_of_inputs + custom_calls_const_itr->second.number_of_custom_inputs);
+		boost::string_ref rows_str;
+		if (found != boost::string_ref::npos)
+		{
+			rows_str = batch_str.substr(found+1);
+		}
+		std::vector<boost::string_ref> rows;
+		Tokenizer::split(rows_str, custom_calls_const_itr->second.batch_seperator[0], rows);
+
+		std::vector< std::vector< std::vector<std::string> > > rows_processed_inputs;
+		rows_processed_inputs.reserve(rows.size());
 
-		Poco::StringTokenizer tokens(tokens_str, custom_calls_const_itr->second.seperator);
-		if (expected_inputs != tokens.count())
+		std::string rows_status;
+		rows_status.reserve(rows.size() * 2);
+
+		std::vector<std::string> custom_inputs;
+		std::string player_key;
+		std::string row_result;
+		for (auto &row : rows)
+		{
+			std::vector< std::vector<std::string> > all_processed_inputs;
+			custom_inputs.clear();
+			if (processInputs(custom_calls_const_itr, input_str, row, all_processed_inputs, custom_inputs, player_key, row_result))
+			{
+				rows_processed_inputs.push_back(std::move(all_processed_inputs));
+				rows_status += "1,";
+			}
+			else
+			{
+				rows_status += "0,";
+			}
+		}
+		if (!rows_status.empty())
+		{
+			rows_status.pop_back();
+		}
+
+		bool status = true;
+		if (!rows_processed_inputs.empty())
+		{
+			callBatchPreparedStatement(custom_calls_const_itr, rows_processed_inputs, status, result);
+		}
+		if (status)
 		{
-			// BAD Number of Inputs
-			result = "[0,\"Error Incorrect Number of Inputs\"]";
-			extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Incorrect Number of Inputs: Input String {0}", input_str);
-			extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Incorrect Number of Inputs: Expected: {0} Got: {1}", expected_inputs, tokens.count());
+			if (!rows_processed_inputs.empty())
+			{
+				invalidateResultCaches(custom_calls_const_itr);
+			}
+			result = "[1,[" + rows_status + "]]";
 			#ifdef DEBUG_TESTING
-				extension_ptr->console->warn("extDB2: SQL_CUSTOM_V2: Incorrect Number of Inputs: Input String {0}", input_str);
-				extension_ptr->console->warn("extDB2: SQL_CUSTOM_V2: Incorrect Number of Inputs: Expected: {0} Got: {1}", expected_inputs, tokens.count());
+				extension_ptr->console->info("extDB2: SQL_CUSTOM_V2: Trace: UniqueID: {0} Result: {1}", unique_id, result);
+			#endif
+			#ifdef DEBUG_LOGGING
+				extension_ptr->logger->info("extDB2: SQL_CUSTOM_V2: Trace: UniqueID: {0} Result: {1}", unique_id, result);
 			#endif
 		}
 		else
 		{
-			// GOOD Number of Inputs
-			bool status = true;
+			extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Error: UniqueID: {0} Input String: {1}", unique_id, input_str);
+		}
+	}
+}
 
-			std::vector<std::string> inputs;
-			std::vector<std::string> custom_inputs;
 
-			if (custom_calls_const_itr->second.number_of_custom_inputs == 0)
-			{
-				inputs.insert(inputs.begin(), tokens.begin(), tokens.end());
-			}
-			else
-			{
-				auto itr = tokens.begin();
-				std::advance(itr, custom_calls_const_itr->second.number_of_inputs);
-				inputs.insert(inputs.begin(), tokens.begin(), itr);
+void SQL_CUSTOM_V2::invalidateResultCaches(Custom_Call_UnorderedMap::const_iterator custom_calls_itr)
+// Clears Result Cache of Calls listed in Cache Invalidate, after a successful write
+{
+	for (auto &cache_invalidate_call : custom_calls_itr->second.cache_invalidate_calls)
+	{
+		auto invalidate_itr = custom_calls.find(cache_invalidate_call);
+		if ((invalidate_itr != custom_calls.end()) && (invalidate_itr->second.result_cache))
+		{
+			invalidate_itr->second.result_cache->clear();
+		}
+	}
+}
 
-				custom_inputs.insert(custom_inputs.begin(), itr, tokens.end());
 
-				for (auto &custom_input : custom_inputs)
-				{
-					for (auto &strip_char : custom_calls_const_itr->second.strip_custom_input_chars)
-					{
-						boost::erase_all(custom_input, std::string(1, strip_char));
-					}
-				}
-			}
+void SQL_CUSTOM_V2::queueWriteBehind_mutexlock(Custom_Call_UnorderedMap::const_iterator custom_calls_itr, const boost::string_ref &tokens_str, std::vector< std::vector<std::string> > &all_processed_inputs)
+// Queues One-way Call, replacing any queued Call with the same Write Behind Key
+{
+	// Write Behind Key == Input Number, 0 == All Inputs
+	std::string key;
+	if (custom_calls_itr->second.write_behind_key <= 0)
+	{
+		key = tokens_str.to_string();
+	}
+	else
+	{
+		std::vector<boost::string_ref> tokens;
+		Tokenizer::split(tokens_str, custom_calls_itr->second.seperator[0], tokens);
+		if (custom_calls_itr->second.write_behind_key <= tokens.size())
+		{
+			key = tokens[custom_calls_itr->second.write_behind_key - 1].to_string();
+		}
+	}
 
-			// Multiple INPUT Lines
-			std::vector<std::vector<std::string> > all_processed_inputs;
-			all_processed_inputs.reserve(custom_calls_const_itr->second.sql_inputs_options.size());
+	writeBehindQueue &queue = *(write_behind_queues.at(custom_calls_itr->first));
+	bool flush = false;
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex_queue);
+		auto keys_pos_itr = queue.keys_pos.find(key);
+		if (keys_pos_itr != queue.keys_pos.end())
+		{
+			queue.rows_processed_inputs[keys_pos_itr->second] = std::move(all_processed_inputs);
+		}
+		else
+		{
+			queue.keys_pos[key] = queue.rows_processed_inputs.size();
+			queue.rows_processed_inputs.push_back(std::move(all_processed_inputs));
+		}
 
-			std::string sanitize_str;
+		if (queue.flush_posted)
+		{
+			// Flush already waiting on Bulk Worker Lane, it picks up this Call
+		}
+		else if (queue.rows_processed_inputs.size() >= custom_calls_itr->second.write_behind_max_queue)
+		{
+			queue.flush_posted = true;
+			flush = true;
+		}
+		else if (!queue.timer_active)
+		{
+			queue.timer_active = true;
+			queue.timer->expires_from_now(boost::posix_time::milliseconds(custom_calls_itr->second.write_behind_interval));
+			queue.timer->async_wait(boost::bind(&SQL_CUSTOM_V2::timerWriteBehind, this, boost::asio::placeholders::error, custom_calls_itr->first));
+		}
+	}
+	if (flush)
+	{
+		// Flush always runs on Bulk Worker Lane, not the Worker that queued the Call
+		extension_ptr->getBulkIOService().post(boost::bind(&SQL_CUSTOM_V2::flushWriteBehind_mutexlock, this, custom_calls_itr->first));
+	}
+}
+
+
+void SQL_CUSTOM_V2::timerWriteBehind(const boost::system::error_code& ec, const std::string &call_name)
+{
+	if (ec != boost::asio::error::operation_aborted)
+	{
+		flushWriteBehind_mutexlock(call_name);
+	}
+}
+
+
+void SQL_CUSTOM_V2::flushWriteBehind_mutexlock(const std::string &call_name)
+// Swaps out queued Calls + runs them as one Batch, queue is unlocked while the Batch runs
+{
+	auto custom_calls_itr = custom_calls.find(call_name);
+	writeBehindQueue &queue = *(write_behind_queues.at(call_name));
+
+	std::vector< std::vector< std::vector<std::string> > > rows_processed_inputs;
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex_queue);
+		rows_processed_inputs.swap(queue.rows_processed_inputs);
+		queue.keys_pos.clear();
+		queue.flush_posted = false;
+		if (queue.timer_active)
+		{
+			queue.timer_active = false;
+			queue.timer->cancel(); // Flushed by Max Queue, Timer Handler finds an empty Queue
+		}
+	}
 
-			std::string player_key;
-			for(auto &sql_inputs_options : custom_calls_const_itr->second.sql_inputs_options)
+	if (!rows_processed_inputs.empty())
+	{
+		bool status = true;
+		std::string result;
+		callBatchPreparedStatement(custom_calls_itr, rows_processed_inputs, status, result);
+		if (!status && (rows_processed_inputs.size() > 1))
+		{
+			// Batch rolled back, retry each Row in its own Transaction so a bad Row only drops itself
+			#ifdef DEBUG_TESTING
+				extension_ptr->console->warn("extDB2: SQL_CUSTOM_V2: Write Behind Batch Error, retrying Rows: Call: {0} Rows: {1} Result: {2}", call_name, rows_processed_inputs.size(), result);
+			#endif
+			extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Write Behind Batch Error, retrying Rows: Call: {0} Rows: {1} Result: {2}", call_name, rows_processed_inputs.size(), result);
+			std::vector< std::vector< std::vector<std::string> > > row_processed_inputs(1);
+			for (auto &processed_inputs : rows_processed_inputs)
 			{
-				std::vector< std::string > processed_inputs;
-				for(auto &sql_input_option : sql_inputs_options)
+				bool row_status = true;
+				result.clear();
+				row_processed_inputs[0].swap(processed_inputs);
+				callBatchPreparedStatement(custom_calls_itr, row_processed_inputs, row_status, result);
+				row_processed_inputs[0].swap(processed_inputs);
+				if (row_status)
+				{
+					status = true; // At least one Row written
+				}
+				else
 				{
-					std::string temp_str = inputs[sql_input_option.number];
-					// INPUT Options
+					#ifdef DEBUG_TESTING
+						extension_ptr->console->warn("extDB2: SQL_CUSTOM_V2: Write Behind Error: Call: {0} Result: {1}", call_name, result);
+					#endif
+					extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Write Behind Error: Call: {0} Result: {1}", call_name, result);
+				}
+			}
+		}
+		else if (!status)
+		{
+			#ifdef DEBUG_TESTING
+				extension_ptr->console->warn("extDB2: SQL_CUSTOM_V2: Write Behind Error: Call: {0} Result: {1}", call_name, result);
+			#endif
+			extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Write Behind Error: Call: {0} Result: {1}", call_name, result);
+		}
+		if (status)
+		{
+			invalidateResultCaches(custom_calls_itr);
+		}
+	}
+}
 
-					// Strip
-					if (sql_input_option.strip)
-					{
-						for (auto &strip_char : custom_calls_const_itr->second.strip_chars)
-						{
-							boost::erase_all(temp_str, std::string(1, strip_char));
-						}
-						if (temp_str != inputs[sql_input_option.number])
-						{
-							switch (custom_calls_const_itr->second.strip_chars_action)
-							{
-								case 3: // Strip + Log + Error
-									status = false;
-								case 2: // Strip + Log
-									extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Error Bad Char Detected: Input: {0}", input_str);
-									extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Error Bad Char Detected: Token: {0}", (sql_input_option.number));
-								case 1: // Strip
-									result = "[0,\"Error Strip Char Found\"]";
-									break;
-							}
-						}
-					}
 
-					// STEAM ID + QUERYS
-					if (sql_input_option.vac_steamID)
-					{
-						// QUERY STEAM
-						extension_ptr->steamQuery(-1, false, true, temp_str, true);
-					}
-					if (sql_input_option.beguid)
-					{
-						// GENERATE BEGUID
-						getBEGUID(temp_str, temp_str);
-						if (sql_input_option.return_player_key)
-						{
-							extension_ptr->getPlayerKey_BEGuid(temp_str, player_key);
-						}
-					}
-					else if (sql_input_option.return_player_key)
-					{
-						extension_ptr->getPlayerKey_SteamID(temp_str, player_key);
-					}
+bool SQL_CUSTOM_V2::callProtocol(std::string input_str, std::string &result, const bool async_method, const unsigned int unique_id)
+{
+	#ifdef DEBUG_TESTING
+		extension_ptr->console->info("extDB2: SQL_CUSTOM_V2: Trace: UniqueID: {0} Input: {1}", unique_id, input_str);
+	#endif
+	#ifdef DEBUG_LOGGING
+		extension_ptr->logger->info("extDB2: SQL_CUSTOM_V2: Trace: UniqueID: {0} Input: {1}", unique_id, input_str);
+	#endif
 
+	// Tokens point into input_str, no copies
+	const std::string::size_type found = input_str.find(default_seperator);
+	const std::string callname = input_str.substr(0, found);
+	boost::string_ref tokens_str;
+	if (found != std::string::npos)
+	{
+		tokens_str = boost::string_ref(input_str).substr(found+1);
+	}
 
-					// STRING
-					if (sql_input_option.string)
-					{
-						if (temp_str.empty())
-						{
-							temp_str = "\"\"";
-						}
-						else
-						{
-							boost::erase_all(temp_str, "\"");
-							boost::erase_all(temp_str, "'");
-							temp_str = "\"" + temp_str + "\"";
-						}
-					}
-					else if (sql_input_option.string_escape_quotes)
-					{
-						if (temp_str.empty())
-						{
-							temp_str = "\"\"";
-						}
-						else
-						{
-							boost::replace_all(temp_str, "\"", "\"\"");
-							boost::replace_all(temp_str, "'", "''");
-							temp_str = "\"" + temp_str + "\"";
-						}
-					}
-					// BOOL
-					else if (sql_input_option.boolean)
-					{
-						if (boost::algorithm::iequals(temp_str, std::string("True")) == 1)
-						{
-							temp_str = "1";
-						}
-						else
-						{
-							temp_str = "0";
-						}
-					}
+	auto custom_calls_const_itr = custom_calls.find(callname);
+	if ((custom_calls_const_itr == custom_calls.end()) && (callname == "BATCH"))
+	{
+		callBatch(input_str, tokens_str, result, unique_id);
+	}
+	else if (custom_calls_const_itr == custom_calls.end())
+	{
+		// NO CALLNAME FOUND IN PROTOCOL
+		result = "[0,\"Error No Custom Call Not Found\"]";
+		extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Error No Custom Call Not Found: Input String {0}", input_str);
+		extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Error No Custom Call Not Found: Callname {0}", callname);
+		#ifdef DEBUG_TESTING
+			extension_ptr->console->warn("extDB2: SQL_CUSTOM_V2: Error No Custom Call Not Found: Input String {0}", input_str);
+			extension_ptr->console->warn("extDB2: SQL_CUSTOM_V2: Error No Custom Call Not Found: Callname {0}", callname);
+		#endif
+	}
+	else
+	{
+		std::vector< std::vector<std::string> > all_processed_inputs;
+		std::vector<std::string> custom_inputs;
+		std::string player_key;
 
-					// SANITIZE CHECK
-					if (sql_input_option.check)
-					{
-						sanitize_str = temp_str;
-						if (sql_input_option.check_add_quotes)
-						{
-							sanitize_str = "\"" + sanitize_str + "\"";
-						}
-						else if (sql_input_option.check_add_escape_quotes)
-						{
-							boost::replace_all(temp_str, "\"", "\"\"");
-							boost::replace_all(temp_str, "'", "''");
-							sanitize_str = "\"" + temp_str + "\"";
-						}
+		// Inputs are processed before the Result Cache, so Input side effects still happen on a Cache Hit (Vac_SteamID Steam Queries, Sanitize / Strip Warnings)
+		bool status = processInputs(custom_calls_const_itr, input_str, tokens_str, all_processed_inputs, custom_inputs, player_key, result);
 
-						if (!(Sqf::check(sanitize_str)))
-						{
-							status = false;
-							extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Sanitize Check Error: Input: {0}", input_str);
-							extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Sanitize Check Error: Value: {0}", sanitize_str);
-							result = "[0,\"Error Input Value is not sanitized\"]";
-						}
-					}
-					processed_inputs.push_back(std::move(temp_str));
-				}
-				all_processed_inputs.push_back(std::move(processed_inputs));
+		// Result Cache, answers without taking a Session from the Pool
+		if (status && custom_calls_const_itr->second.result_cache)
+		{
+			Poco::SharedPtr<std::string> cached_result = custom_calls_const_itr->second.result_cache->get(tokens_str.to_string());
+			if (!cached_result.isNull())
+			{
+				++result_cache_hits;
+				result = *cached_result;
+				return true;
 			}
+			++result_cache_misses;
+		}
 
+		if (status && async_method && custom_calls_const_itr->second.write_behind && (unique_id == 1))
+		{
+			// One-way Call, nothing waits for the result
+			queueWriteBehind_mutexlock(custom_calls_const_itr, tokens_str, all_processed_inputs);
+		}
+		else if (status)
+		{
+			callPreparedStatement(callname, custom_calls_const_itr, all_processed_inputs, custom_inputs, player_key, status, result);
 			if (status)
 			{
-				callPreparedStatement(callname, custom_calls_const_itr, all_processed_inputs, custom_inputs, player_key, status, result);
-				#if defined(DEBUG_TESTING) || defined(DEBUG_LOGGING)
-					if (status)
-					{
-						#ifdef DEBUG_TESTING
-							extension_ptr->console->info("extDB2: SQL_CUSTOM_V2: Trace: UniqueID: {0} Result: {1}", unique_id, result);
-						#endif
-						#ifdef DEBUG_LOGGING
-							extension_ptr->logger->info("extDB2: SQL_CUSTOM_V2: Trace: UniqueID: {0} Result: {1}", unique_id, result);
-						#endif
-					}
-				#endif
-			}
-			if (!status)
-			{
-				extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Error: UniqueID: {0} Input String: {1}", unique_id, input_str);
+				if (custom_calls_const_itr->second.result_cache)
+				{
+					custom_calls_const_itr->second.result_cache->add(tokens_str.to_string(), result);
+				}
+				invalidateResultCaches(custom_calls_const_itr);
 			}
+			#if defined(DEBUG_TESTING) || defined(DEBUG_LOGGING)
+				if (status)
+				{
+					#ifdef DEBUG_TESTING
+						extension_ptr->console->info("extDB2: SQL_CUSTOM_V2: Trace: UniqueID: {0} Result: {1}", unique_id, result);
+					#endif
+					#ifdef DEBUG_LOGGING
+						extension_ptr->logger->info("extDB2: SQL_CUSTOM_V2: Trace: UniqueID: {0} Result: {1}", unique_id, result);
+					#endif
+				}
+			#endif
+		}
+		if (!status)
+		{
+			extension_ptr->logger->warn("extDB2: SQL_CUSTOM_V2: Error: UniqueID: {0} Input String: {1}", unique_id, input_str);
 		}
 	}
 	return true;
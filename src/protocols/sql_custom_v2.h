@@ -18,13 +18,22 @@ along with this program. If not, see <http://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include <atomic>
+#include <list>
+#include <memory>
 #include <thread>
 #include <unordered_map>
 
+#include <boost/asio.hpp>
+#include <boost/utility/string_ref.hpp>
+
 #include <Poco/DynamicAny.h>
-#include <Poco/MD5Engine.h>
+#include <Poco/ExpireLRUCache.h>
 #include <Poco/StringTokenizer.h>
 
+#include <Poco/Data/MetaColumn.h>
+#include <Poco/Data/RecordSet.h>
+
 #include "abstract_protocol.h"
 
 #define EXTDB_SQL_CUSTOM_V2_REQUIRED_VERSION 8
@@ -36,12 +45,12 @@ class SQL_CUSTOM_V2: public AbstractProtocol
 	public:
 		bool init(AbstractExt *extension, const std::string &database_id, const std::string &init_str);
 		bool callProtocol(std::string input_str, std::string &result, const bool async_method, const unsigned int unique_id=1);
+		void getStats(std::string &result);
+		bool isBulkCall(const boost::string_ref &input_str);
 
 	private:
 		std::string default_seperator;
-
-		Poco::MD5Engine md5;
-		std::mutex mutex_md5;
+		std::string default_batch_seperator;
 
 		struct Value_Options
 		{
@@ -71,6 +80,10 @@ class SQL_CUSTOM_V2: public AbstractProtocol
 			bool preparedStatement_cache;
 			bool returnInsertID;
 			bool returnPlayerKey;
+			bool bulk;
+			bool read_only; // Read Replicas, BATCH + Write Behind always use Primary
+			bool transaction; // SQL1..SQLn in one Transaction, BATCH is always one Transaction
+			int output_format; // 0 == SQF, 1 == Simple Array, 2 == Columnar
 
 			int number_of_inputs;
 			int number_of_custom_inputs;
@@ -80,6 +93,16 @@ class SQL_CUSTOM_V2: public AbstractProtocol
 			std::string strip_custom_input_chars;
 
 			std::string seperator;
+			std::string batch_seperator;
+
+			bool write_behind;
+			int write_behind_key;
+			int write_behind_interval;
+			std::size_t write_behind_max_queue;
+
+			// Result Cache, keyed by Inputs
+			std::shared_ptr<Poco::ExpireLRUCache<std::string, std::string> > result_cache;
+			std::vector<std::string> cache_invalidate_calls;
 
 			std::vector< std::string> sql_prepared_statements;
 
@@ -91,10 +114,74 @@ class SQL_CUSTOM_V2: public AbstractProtocol
 
 		Custom_Call_UnorderedMap custom_calls;
 
+		// Prepared Statement Cache
+		//   Custom Poco SessionPool caches Prepared Statements per Session in statements_map (keyed by SQL String)
+		//   Tracked here in LRU order per Session, so statements_map stays bounded + errors only invalidate the statements used
+		//   Custom Input Statements have their own smaller LRU, so they can't evict the static statements
+		struct statementsLRU
+		{
+			std::list<std::string> sql_strs; // Most recently used at front
+			std::unordered_map<std::string, std::list<std::string>::iterator> sql_strs_itrs;
+		};
+		struct sessionStatements
+		{
+			Poco::Data::SessionPool::SessionDataPtr session_data_ptr;
+			statementsLRU statements;
+			statementsLRU custom_statements;
+		};
+		std::unordered_map<const void *, sessionStatements> sessions_statements;
+		std::mutex mutex_sessions_statements;
+
+		std::size_t statements_cache_size;
+		std::size_t custom_statements_cache_size;
+
+		std::atomic<unsigned int> statements_cache_hits;
+		std::atomic<unsigned int> statements_cache_misses;
+		std::atomic<unsigned int> statements_cache_evictions;
+		std::atomic<unsigned int> statements_cache_invalidations;
+
+		std::atomic<unsigned int> result_cache_hits;
+		std::atomic<unsigned int> result_cache_misses;
+
+		// Write Behind
+		//   One-way Calls are queued + coalesced by Write Behind Key (latest inputs win), then flushed as a Batch
+		//   Flushed when Write Behind Max Queue is reached or Write Behind Interval (ms) after first queued call
+		struct writeBehindQueue
+		{
+			std::unordered_map<std::string, std::size_t> keys_pos;
+			std::vector< std::vector< std::vector<std::string> > > rows_processed_inputs;
+			std::unique_ptr<boost::asio::deadline_timer> timer;
+			bool timer_active = false;
+			bool flush_posted = false;
+			std::mutex mutex_queue;
+		};
+		std::unordered_map<std::string, std::unique_ptr<writeBehindQueue> > write_behind_queues;
+
+		void invalidateResultCaches(Custom_Call_UnorderedMap::const_iterator custom_calls_itr);
+
+		void queueWriteBehind_mutexlock(Custom_Call_UnorderedMap::const_iterator custom_calls_itr, const boost::string_ref &tokens_str, std::vector< std::vector<std::string> > &all_processed_inputs);
+		void flushWriteBehind_mutexlock(const std::string &call_name);
+		void timerWriteBehind(const boost::system::error_code& ec, const std::string &call_name);
+
+		sessionStatements &getSessionStatements_mutexlock(Poco::Data::SessionPool::SessionDataPtr &session_data_ptr);
+		void cacheStatement(Poco::Data::SessionPool::SessionDataPtr &session_data_ptr, statementsLRU &statements_lru, const std::size_t &max_size, const std::string &sql_str);
+		void invalidateStatement(Poco::Data::SessionPool::SessionDataPtr &session_data_ptr, statementsLRU &statements_lru, const std::string &sql_str);
+
+		bool processInputs(Custom_Call_UnorderedMap::const_iterator custom_calls_itr, const std::string &input_str, const boost::string_ref &tokens_str, std::vector< std::vector<std::string> > &all_processed_inputs, std::vector<std::string> &custom_inputs, std::string &player_key, std::string &result);
+
+		void rollbackSession(std::unique_ptr<Poco::Data::Session> &session_ptr);
+
+		void callBatch(const std::string &input_str, const boost::string_ref &batch_str, std::string &result, const unsigned int unique_id);
+		void callBatchPreparedStatement(Custom_Call_UnorderedMap::const_iterator custom_calls_itr, std::vector< std::vector< std::vector<std::string> > > &rows_processed_inputs, bool &status, std::string &result);
 		void callPreparedStatement(std::string call_name, Custom_Call_UnorderedMap::const_iterator custom_calls_itr, std::vector< std::vector<std::string> > &all_processed_inputs, std::vector<std::string> &custom_inputs, std::string &player_key, bool &status, std::string &result);
 
 		void executeSQL(Poco::Data::Statement &sql_statement, std::string &result, bool &status);
 
 		void getBEGUID(std::string &input_str, std::string &result);
+
+		int getOutputFormat(const std::string &output_format_str, const std::string &call_name);
+		bool isIntegerColumn(const Poco::Data::MetaColumn::ColumnDataType &column_type);
+		bool isNumberColumn(const Poco::Data::MetaColumn::ColumnDataType &column_type);
+		void getValue(Poco::Data::RecordSet &rs, const Poco::Data::MetaColumn::ColumnDataType &column_type, const std::size_t &col, const std::size_t &row, std::string &value);
 		void getResult(std::unordered_map<std::string, customCall>::const_iterator &custom_protocol_itr, Poco::Data::Session &session, Poco::Data::Statement &sql_statement, std::string &player_key, std::string &result, bool &status);
 };
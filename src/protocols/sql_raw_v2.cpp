@@ -30,6 +30,8 @@ along with this program. If not, see <http://www.gnu.org/licenses/>.
 
 #include <Poco/Exception.h>
 
+#include "../sanitize.h"
+
 
 bool SQL_RAW_V2::init(AbstractExt *extension, const std::string &database_id, const std::string &init_str)
 {
@@ -82,6 +84,22 @@ bool SQL_RAW_V2::init(AbstractExt *extension, const std::string &database_id, co
 			#endif
 			extension_ptr->logger->info("extDB2: SQL_RAW_V2: Initialized: ADD_QUOTES True");
 		}
+		else if (boost::algorithm::iequals(init_str, std::string("SIMPLE_ARRAY")))
+		{
+			output_format = 1;
+			#ifdef DEBUG_TESTING
+				extension_ptr->console->info("extDB2: SQL_RAW_V2: Initialized: SIMPLE_ARRAY");
+			#endif
+			extension_ptr->logger->info("extDB2: SQL_RAW_V2: Initialized: SIMPLE_ARRAY");
+		}
+		else if (boost::algorithm::iequals(init_str, std::string("COLUMNAR")))
+		{
+			output_format = 2;
+			#ifdef DEBUG_TESTING
+				extension_ptr->console->info("extDB2: SQL_RAW_V2: Initialized: COLUMNAR");
+			#endif
+			extension_ptr->logger->info("extDB2: SQL_RAW_V2: Initialized: COLUMNAR");
+		}
 		else
 		{
 			status = false;
@@ -91,6 +109,92 @@ bool SQL_RAW_V2::init(AbstractExt *extension, const std::string &database_id, co
 }
 
 
+void SQL_RAW_V2::getTypedResult(Poco::Data::RecordSet &rs, const std::size_t &cols, std::string &result)
+// SIMPLE_ARRAY: [[row1 col1,row1 col2],[row2 col1,...]]  COLUMNAR: [[row1 col1,row2 col1,...],[row1 col2,...]]
+//   Numbers as is, everything else quoted + escaped (NULL == ""), so parseSimpleArray can read the result
+{
+	std::vector<bool> number_columns;
+	number_columns.reserve(cols);
+	for (std::size_t col = 0; col < cols; ++col)
+	{
+		switch (rs.columnType(col))
+		{
+			case Poco::Data::MetaColumn::FDT_INT8:
+			case Poco::Data::MetaColumn::FDT_UINT8:
+			case Poco::Data::MetaColumn::FDT_INT16:
+			case Poco::Data::MetaColumn::FDT_UINT16:
+			case Poco::Data::MetaColumn::FDT_INT32:
+			case Poco::Data::MetaColumn::FDT_UINT32:
+			case Poco::Data::MetaColumn::FDT_INT64:
+			case Poco::Data::MetaColumn::FDT_UINT64:
+			case Poco::Data::MetaColumn::FDT_FLOAT:
+			case Poco::Data::MetaColumn::FDT_DOUBLE:
+				number_columns.push_back(true);
+				break;
+			default:
+				number_columns.push_back(false);
+		}
+	}
+
+	std::vector<std::string> columns_results;
+	if (output_format == 2)
+	{
+		columns_results.resize(cols);
+	}
+
+	std::string temp_str;
+	bool first_row = true;
+	bool more = rs.moveFirst();
+	while (more)
+	{
+		if (output_format == 1)
+		{
+			result += first_row ? "[" : ",[";
+		}
+		for (std::size_t col = 0; col < cols; ++col)
+		{
+			std::string &value_result = (output_format == 2) ? columns_results[col] : result;
+			if ((output_format == 2) ? (!first_row) : (col > 0))
+			{
+				value_result += ",";
+			}
+			if (rs[col].isEmpty())
+			{
+				value_result += "\"\"";
+			}
+			else
+			{
+				temp_str = rs[col].convert<std::string>();
+				if (number_columns[col])
+				{
+					value_result += temp_str;
+				}
+				else
+				{
+					Sqf::appendString(value_result, temp_str);
+				}
+			}
+		}
+		if (output_format == 1)
+		{
+			result += "]";
+		}
+		first_row = false;
+		more = rs.moveNext();
+	}
+
+	if ((output_format == 2) && !first_row)
+	{
+		for (std::size_t col = 0; col < cols; ++col)
+		{
+			result += (col == 0) ? "[" : ",[";
+			result += columns_results[col];
+			result += "]";
+		}
+	}
+}
+
+
 bool SQL_RAW_V2::callProtocol(std::string input_str, std::string &result, const bool async_method, const unsigned int unique_id)
 {
 	try
@@ -110,7 +214,11 @@ bool SQL_RAW_V2::callProtocol(std::string input_str, std::string &result, const
 		temp_str.reserve(result.capacity());
 
 		std::size_t cols = rs.columnCount();
-		if (cols >= 1)
+		if ((cols >= 1) && (output_format != 0))
+		{
+			getTypedResult(rs, cols, result);
+		}
+		else if (cols >= 1)
 		{
 			bool more = rs.moveFirst();
 			if (more)
@@ -18,6 +18,8 @@ along with this program. If not, see <http://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include <Poco/Data/RecordSet.h>
+
 #include "abstract_protocol.h"
 
 
@@ -29,4 +31,7 @@ class SQL_RAW_V2: public AbstractProtocol
 
 	private:
 		bool stringDataTypeCheck;
+		int output_format = 0; // 0 == SQF, 1 == SIMPLE_ARRAY, 2 == COLUMNAR
+
+		void getTypedResult(Poco::Data::RecordSet &rs, const std::size_t &cols, std::string &result);
 };
@@ -20,13 +20,364 @@ along with this program. If not, see <http://www.gnu.org/licenses/>.
 
 #include "sanitize.h"
 
+#include <cstring>
 #include <string>
 #include <vector>
 
-#include <boost/config/warning_disable.hpp>
-#include <boost/spirit/include/qi.hpp>
+#ifdef SANITIZE_APP
+	#include <cstdlib>
+	#include <iostream>
+	#include <random>
+
+	#include <boost/config/warning_disable.hpp>
+	#include <boost/spirit/include/qi.hpp>
+#endif
+
+
+namespace
+{
+	// Hand written version of the old Boost.Spirit grammar (kept below for SANITIZE_APP fuzz testing)
+	//   Single pass + no allocations, accepts exactly the same inputs
+	//   Spirit quirks are kept on purpose, i.e. a double with out of range exponent fails without backtracking
+
+	inline bool isSpace(const char c)
+	{
+		return ((c == ' ') || ((c >= '\t') && (c <= '\r')));
+	}
+
+	inline bool isDigit(const char c)
+	{
+		return ((c >= '0') && (c <= '9'));
+	}
+
+	inline void skipSpaces(const char *&pos, const char *end)
+	{
+		while ((pos != end) && isSpace(*pos))
+		{
+			++pos;
+		}
+	}
+
+	inline const char *skipDigits(const char *pos, const char *end)
+	{
+		while ((pos != end) && isDigit(*pos))
+		{
+			++pos;
+		}
+		return pos;
+	}
+
+	inline bool matchNoCase(const char *&pos, const char *end, const char *lower_str)
+	{
+		const char *itr = pos;
+		for (; *lower_str != '\0'; ++lower_str, ++itr)
+		{
+			if ((itr == end) || ((*itr != *lower_str) && (*itr != (*lower_str - ('a' - 'A')))))
+			{
+				return false;
+			}
+		}
+		pos = itr;
+		return true;
+	}
 
+	inline bool match(const char *&pos, const char *end, const char *str, const std::size_t len)
+	{
+		if ((static_cast<std::size_t>(end - pos) >= len) && (std::memcmp(pos, str, len) == 0))
+		{
+			pos += len;
+			return true;
+		}
+		return false;
+	}
 
+	// Signed Integer, leading zeros ignored, fails on overflow
+	bool parseInteger(const char *&pos, const char *end, const unsigned long long max_positive, unsigned long long &value, bool &negative)
+	{
+		const char *itr = pos;
+		negative = false;
+		if ((itr != end) && ((*itr == '-') || (*itr == '+')))
+		{
+			negative = (*itr == '-');
+			++itr;
+		}
+		const unsigned long long max_value = (negative ? (max_positive + 1) : max_positive);
+		const char *digits_start = itr;
+		while ((itr != end) && (*itr == '0'))
+		{
+			++itr;
+		}
+		value = 0;
+		for (; (itr != end) && isDigit(*itr); ++itr)
+		{
+			const unsigned int digit = (*itr - '0');
+			if ((value > (max_value / 10)) || ((value * 10) > (max_value - digit)))
+			{
+				return false;
+			}
+			value = (value * 10) + digit;
+		}
+		if (itr == digits_start)
+		{
+			return false;
+		}
+		pos = itr;
+		return true;
+	}
+
+	// Spirit strict_real_policies<double>, returns 1 = match, 0 = no match, -1 = no match but pos is advanced (exponent out of range)
+	int parseStrictDouble(const char *&pos, const char *end)
+	{
+		const char *itr = pos;
+		if ((itr != end) && ((*itr == '-') || (*itr == '+')))
+		{
+			++itr;
+		}
+
+		// Integer Part, first 17 digits are accumulated (leading zeros count), rest are excess digits
+		const char *digits_start = itr;
+		unsigned long long acc = 0;
+		while ((itr != end) && (*itr == '0') && ((itr - digits_start) < 17))
+		{
+			++itr;
+		}
+		for (; (itr != end) && isDigit(*itr) && ((itr - digits_start) < 17); ++itr)
+		{
+			acc = (acc * 10) + (*itr - '0');
+		}
+		const bool got_a_number = (itr != digits_start);
+		const char *excess_start = itr;
+		itr = skipDigits(itr, end);
+		const long long excess_n = (itr - excess_start);
+
+		if (!got_a_number)
+		{
+			if ((itr != end) && ((*itr == 'n') || (*itr == 'N')))
+			{
+				const char *nan_itr = itr;
+				if (matchNoCase(nan_itr, end, "nan"))
+				{
+					if ((nan_itr == end) || (*nan_itr != '('))
+					{
+						pos = nan_itr;
+						return 1;
+					}
+					const char *close_ptr = static_cast<const char *>(std::memchr(nan_itr, ')', (end - nan_itr)));
+					if (close_ptr != nullptr)
+					{
+						pos = close_ptr + 1;
+						return 1;
+					}
+				}
+			}
+			else if (matchNoCase(itr, end, "inf"))
+			{
+				matchNoCase(itr, end, "inity");
+				pos = itr;
+				return 1;
+			}
+		}
+
+		long long frac_digits = 0;
+		if ((itr != end) && (*itr == '.'))
+		{
+			++itr;
+			if ((itr != end) && isDigit(*itr))
+			{
+				if (excess_n == 0)
+				{
+					// Fraction digits are accumulated until unsigned 64bit overflow, rest are ignored
+					const unsigned long long max_value = static_cast<unsigned long long>(-1);
+					const char *frac_start = itr;
+					for (; (itr != end) && isDigit(*itr); ++itr)
+					{
+						const unsigned int digit = (*itr - '0');
+						if ((acc > (max_value / 10)) || ((acc * 10) > (max_value - digit)))
+						{
+							break;
+						}
+						acc = (acc * 10) + digit;
+					}
+					frac_digits = (itr - frac_start);
+				}
+				itr = skipDigits(itr, end);
+			}
+			else if (!got_a_number)
+			{
+				return 0;
+			}
+		}
+		else if (!got_a_number)
+		{
+			return 0;
+		}
+		else if ((itr == end) || ((*itr != 'e') && (*itr != 'E')))
+		{
+			return 0; // Strict, integers are not doubles
+		}
+
+		// Spirit scale(), fails if double can't hold exponent
+		if ((itr != end) && ((*itr == 'e') || (*itr == 'E')))
+		{
+			const char *exp_itr = itr + 1;
+			bool exp_negative;
+			unsigned long long exp;
+			if (parseInteger(exp_itr, end, 2147483647ULL, exp, exp_negative))
+			{
+				const long long exp10 = (exp_negative ? -static_cast<long long>(exp) : static_cast<long long>(exp)) + excess_n - frac_digits;
+				pos = exp_itr;
+				return (((exp10 > 308) || (exp10 < -614)) ? -1 : 1);
+			}
+			// No exponent number, leave pos before the e|E
+		}
+		else if ((frac_digits == 0) && (excess_n > 308))
+		{
+			pos = itr;
+			return -1;
+		}
+		pos = itr;
+		return 1;
+	}
+
+	bool parseQuotedString(const char *&pos, const char *end)
+	{
+		const char quote = *pos;
+		const char *close_ptr = static_cast<const char *>(std::memchr(pos + 1, quote, (end - pos - 1)));
+		if (close_ptr == nullptr)
+		{
+			return false;
+		}
+		// ASCII only
+		for (const char *itr = pos + 1; itr != close_ptr; ++itr)
+		{
+			if ((static_cast<unsigned char>(*itr) & 0x80) != 0)
+			{
+				return false;
+			}
+		}
+		pos = close_ptr + 1;
+		return true;
+	}
+
+	bool parseValue(const char *&pos, const char *end);
+
+	bool parseArray(const char *&pos, const char *end)
+	{
+		const char *itr = pos + 1;
+		const char *element_itr = itr;
+		if (parseValue(element_itr, end))
+		{
+			const char *save_itr = element_itr;
+			while (true)
+			{
+				skipSpaces(element_itr, end);
+				if ((element_itr == end) || (*element_itr != ','))
+				{
+					break;
+				}
+				++element_itr;
+				if (!parseValue(element_itr, end))
+				{
+					break;
+				}
+				save_itr = element_itr;
+			}
+			itr = save_itr;
+		}
+		skipSpaces(itr, end);
+		if ((itr == end) || (*itr != ']'))
+		{
+			return false;
+		}
+		pos = itr + 1;
+		return true;
+	}
+
+	// Same as Spirit, pos can be advanced on failure
+	bool parseValue(const char *&pos, const char *end)
+	{
+		skipSpaces(pos, end);
+		if (pos == end)
+		{
+			return false;
+		}
+
+		const int double_result = parseStrictDouble(pos, end);
+		if (double_result == 1)
+		{
+			return true;
+		}
+		else if (double_result == -1)
+		{
+			skipSpaces(pos, end);
+			if (pos == end)
+			{
+				return false;
+			}
+		}
+
+		switch (*pos)
+		{
+			case '"':
+			case '\'':
+				return parseQuotedString(pos, end);
+			case '[':
+				return parseArray(pos, end);
+			case 't':
+				return match(pos, end, "true", 4);
+			case 'f':
+				return match(pos, end, "false", 5);
+			case 'a':
+				return match(pos, end, "any", 3);
+			default:
+			{
+				// int_ >> !digit is covered by long_long
+				bool negative;
+				unsigned long long value;
+				return parseInteger(pos, end, 9223372036854775807ULL, value, negative);
+			}
+		}
+	}
+}
+
+
+namespace Sqf
+{
+	bool check(const std::string &input_str)
+	{
+		const char *pos = input_str.data();
+		const char *end = input_str.data() + input_str.size();
+
+		while (parseValue(pos, end));
+		skipSpaces(pos, end);
+		return (pos == end); // fail if we did not get a full match
+	};
+
+
+	void appendString(std::string &result, const std::string &value)
+	// Quoted SQF String, " escaped as "" so call compile + parseSimpleArray both read the original value
+	{
+		result += '"';
+		const char *pos = value.data();
+		const char *end = value.data() + value.size();
+		while (pos != end)
+		{
+			const char *quote_ptr = static_cast<const char *>(std::memchr(pos, '"', (end - pos)));
+			if (quote_ptr == nullptr)
+			{
+				result.append(pos, (end - pos));
+				break;
+			}
+			result.append(pos, (quote_ptr - pos) + 1);
+			result += '"';
+			pos = quote_ptr + 1;
+		}
+		result += '"';
+	}
+}
+
+
+#ifdef SANITIZE_APP
 template <typename Iterator, typename Skipper>
 	struct SqfValueParser : boost::spirit::qi::grammar<Iterator, Sqf::Value(), Skipper>
 {
@@ -63,9 +414,10 @@ struct SqfParametersParser : boost::spirit::qi::grammar<Iterator, Sqf::Parameter
 	boost::spirit::qi::rule<Iterator, Sqf::Parameters(), Skipper> start;
 };
 
+
 namespace Sqf
 {
-	bool check(std::string input_str)
+	bool checkSpirit(std::string input_str)
 	{
 		std::string::iterator first = input_str.begin();
 		std::string::iterator last = input_str.end();
@@ -87,16 +439,53 @@ namespace Sqf
 	};
 }
 
-#ifdef SANITIZE_APP
+
+// Differential Fuzz Test, hand written Sqf::check vs old Spirit Grammar
+void fuzzCheck(const int &number_of_tests)
+{
+	// Biased towards SQF syntax + numeric edge cases
+	const std::vector<std::string> fragments = {
+		"[", "]", ",", " ", "\t", "\"", "'", "-", "+", ".", "e", "E", "e-", "e+",
+		"0", "1", "5", "9", "00000", "12345678901234567890", "2147483648", "9223372036854775808",
+		"e308", "e309", "e-614", "e-615", "e2147483648", "1e999", "nan", "NaN(", ")", "inf", "Infinity",
+		"true", "false", "any", "tru", "a", "x", "\xC3\xA9", "\"abc\"", "'a\"b'", "[1,2]", "[]", "\n"
+	};
+	std::mt19937 random_generator(std::random_device{}());
+	std::uniform_int_distribution<std::size_t> fragments_distribution(0, fragments.size() - 1);
+	std::uniform_int_distribution<int> length_distribution(0, 12);
+
+	int mismatches = 0;
+	std::string input_str;
+	for (int i = 0; i < number_of_tests; ++i)
+	{
+		input_str.clear();
+		for (int length = length_distribution(random_generator); length > 0; --length)
+		{
+			input_str += fragments[fragments_distribution(random_generator)];
+		}
+		if (Sqf::check(input_str) != Sqf::checkSpirit(input_str))
+		{
+			++mismatches;
+			std::cout << "extDB: Sanitize Fuzz Mismatch: Check: " << Sqf::check(input_str) << " Spirit: " << Sqf::checkSpirit(input_str) << " Input: " << input_str << std::endl;
+		}
+	}
+	std::cout << "extDB: Sanitize Fuzz: Tests: " << number_of_tests << " Mismatches: " << mismatches << std::endl;
+}
+
+
 int main(int nNumberofArgs, char* pszArgs[])
 {
 	std::string input_str;
 	for (;;) {
 		std::getline(std::cin, input_str);
-		if (input_str == "quit")
+		if ((input_str == "quit") || (std::cin.fail()))
 		{
 			break;
 		}
+		else if (input_str.compare(0, 5, "fuzz ") == 0)
+		{
+			fuzzCheck(std::atoi(input_str.c_str() + 5));
+		}
 		else
 		{
 			if (Sqf::check(input_str))
@@ -111,4 +500,4 @@ int main(int nNumberofArgs, char* pszArgs[])
 	}
 	return 0;
 }
-#endif
\ No newline at end of file
+#endif
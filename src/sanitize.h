@@ -33,5 +33,6 @@ namespace Sqf
 	typedef std::vector<Value> Parameters;
 	typedef std::string::iterator iter_t;
 
-	bool check(std::string input_str);
+	bool check(const std::string &input_str);
+	void appendString(std::string &result, const std::string &value);
 }
\ No newline at end of file
@@ -0,0 +1,81 @@
+/*
+Copyright (C) 2014 Declan Ireland <http://github.com/torndeco/extDB2>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include <boost/utility/string_ref.hpp>
+
+
+namespace Tokenizer
+{
+	// Splits input_str without copying, tokens point into input_str
+	//   Same tokens as Poco::StringTokenizer (no options), empty input_str == 0 tokens
+	//   Returns number of tokens, can be more than tokens.size() (extra tokens are not stored)
+	template <std::size_t N>
+	inline std::size_t split(const boost::string_ref &input_str, const char seperator, std::array<boost::string_ref, N> &tokens)
+	{
+		if (input_str.empty())
+		{
+			return 0;
+		}
+		std::size_t count = 0;
+		const char *start_ptr = input_str.data();
+		const char *end_ptr = input_str.data() + input_str.size();
+		while (true)
+		{
+			const char *found_ptr = static_cast<const char *>(std::memchr(start_ptr, seperator, (end_ptr - start_ptr)));
+			if (count < N)
+			{
+				tokens[count] = boost::string_ref(start_ptr, (((found_ptr == nullptr) ? end_ptr : found_ptr) - start_ptr));
+			}
+			++count;
+			if (found_ptr == nullptr)
+			{
+				break;
+			}
+			start_ptr = found_ptr + 1;
+		}
+		return count;
+	}
+
+	inline void split(const boost::string_ref &input_str, const char seperator, std::vector<boost::string_ref> &tokens)
+	{
+		tokens.clear();
+		if (input_str.empty())
+		{
+			return;
+		}
+		const char *start_ptr = input_str.data();
+		const char *end_ptr = input_str.data() + input_str.size();
+		while (true)
+		{
+			const char *found_ptr = static_cast<const char *>(std::memchr(start_ptr, seperator, (end_ptr - start_ptr)));
+			if (found_ptr == nullptr)
+			{
+				tokens.push_back(boost::string_ref(start_ptr, (end_ptr - start_ptr)));
+				break;
+			}
+			tokens.push_back(boost::string_ref(start_ptr, (found_ptr - start_ptr)));
+			start_ptr = found_ptr + 1;
+		}
+	}
+}